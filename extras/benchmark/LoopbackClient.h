@@ -0,0 +1,141 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: LoopbackClient.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "Client.h"
+
+/**
+ * The recorded response every request is answered with and how it is delivered.
+ */
+struct LoopbackServer {
+    const char* response;
+    size_t responseLength;
+    size_t segmentSize;  // bytes that arrive per tick (0: the whole response at once)
+    bool keepAlive;      // leave the connection open after a response has been read
+    unsigned long tick;  // advanced by the benchmark before every loop() call
+
+    size_t connects;
+    size_t requests;
+    size_t bytesIn;      // bytes the library wrote
+    size_t bytesOut;     // bytes the library read
+};
+
+inline LoopbackServer& loopbackServer() {
+    static LoopbackServer server = LoopbackServer();
+    return server;
+}
+
+/**
+ * Client that never touches the network: every request line written to it queues one copy of
+ * the recorded response. With a segment size set, only that many bytes arrive per tick, like
+ * packets trickling in between two loop() calls.
+ */
+class LoopbackClient : public Client {
+public:
+    LoopbackClient() : open(false), position(0), remaining(0), matched(0), arrived(0), lastTick(0) {}
+
+    int connect(IPAddress, uint16_t) override { return accept(); }
+    int connect(const char*, uint16_t) override { return accept(); }
+
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        LoopbackServer& server = loopbackServer();
+        server.bytesIn += size;
+
+        // a request is recognized by its request line, so pipelined requests are answered in order
+        static const char requestLineEnd[] = " HTTP/1.1\r\n";
+        for (size_t i = 0; i < size; ++i) {
+            matched = buffer[i] == requestLineEnd[matched] ? matched + 1 : (buffer[i] == requestLineEnd[0] ? 1 : 0);
+            if (requestLineEnd[matched] == '\0') {
+                ++server.requests;
+                remaining += server.responseLength;
+                matched = 0;
+            }
+        }
+        return size;
+    }
+
+    int available() override {
+        LoopbackServer& server = loopbackServer();
+        if (server.segmentSize == 0) return (int)remaining;
+
+        if (server.tick != lastTick) {
+            arrived += (server.tick - lastTick) * server.segmentSize;
+            lastTick = server.tick;
+        }
+        if (arrived > remaining) arrived = remaining;
+        return (int)arrived;
+    }
+
+    int read() override {
+        uint8_t b;
+        return read(&b, 1) == 1 ? b : -1;
+    }
+
+    int read(uint8_t* buffer, size_t size) override {
+        LoopbackServer& server = loopbackServer();
+        size_t available = (size_t)this->available();
+        if (size > available) size = available;
+
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] = (uint8_t)server.response[position];
+            if (++position == server.responseLength) position = 0;
+        }
+        remaining -= size;
+        arrived -= size;
+        server.bytesOut += size;
+        return (int)size;
+    }
+
+    int peek() override {
+        return remaining > 0 ? (uint8_t)loopbackServer().response[position] : -1;
+    }
+
+    void flush() override {}
+
+    void stop() override {
+        open = false;
+        remaining = 0;
+        position = 0;
+        arrived = 0;
+    }
+
+    uint8_t connected() override {
+        return open && (loopbackServer().keepAlive || remaining > 0);
+    }
+
+    operator bool() override {
+        return open;
+    }
+
+private:
+    bool open;
+    size_t position;
+    size_t remaining;
+    size_t matched;
+    size_t arrived;
+    unsigned long lastTick;
+
+    int accept() {
+        ++loopbackServer().connects;
+        open = true;
+        position = 0;
+        remaining = 0;
+        matched = 0;
+        arrived = 0;
+        lastTick = loopbackServer().tick;
+        return 1;
+    }
+};
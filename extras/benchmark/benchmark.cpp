@@ -0,0 +1,360 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: benchmark.cpp
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+/**
+ * Host-side benchmark. Drives the library with a loopback client that answers every request with a
+ * recorded response and reports throughput, heap use and loop() latency. See README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <algorithm>
+#include <chrono>
+
+#include "LoopbackClient.h"
+#include "Http.h"
+
+// All heap use of the library is counted, including the one of the String shim.
+void* operator new(size_t size) {
+    void* block = heapAlloc(size);
+    if (block == nullptr) throw std::bad_alloc();
+    return block;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* block) noexcept { heapFree(block); }
+void operator delete[](void* block) noexcept { heapFree(block); }
+void operator delete(void* block, size_t) noexcept { heapFree(block); }
+void operator delete[](void* block, size_t) noexcept { heapFree(block); }
+
+class BenchmarkHttp : public Http<LoopbackClient> {
+public:
+    String getLocalIP() override {
+        return "127.0.0.1";
+    }
+
+    bool resolveHost(const char* host, IPAddress& address) override {
+        address = IPAddress(127, 0, 0, 1);
+        return true;
+    }
+};
+
+/* ----- Results ----- */
+
+struct Metric {
+    char name[64];
+    double value;
+    bool higherIsBetter;
+    bool checked;  // compared against the baseline
+};
+
+static Metric metrics[128];
+static size_t metricCount = 0;
+static bool failed = false;
+
+/**
+ * Records a result. Every scenario runs several times and the best result is kept, which filters
+ * out most of the noise of a busy machine.
+ */
+static void report(const char* scenario, const char* name, double value, bool higherIsBetter = false, bool checked = true) {
+    char fullName[sizeof(metrics[0].name)];
+    snprintf(fullName, sizeof(fullName), "%s.%s", scenario, name);
+
+    for (size_t i = 0; i < metricCount; ++i) {
+        Metric& metric = metrics[i];
+        if (strcmp(metric.name, fullName) != 0) continue;
+        if (higherIsBetter ? value > metric.value : value < metric.value) metric.value = value;
+        return;
+    }
+
+    if (metricCount >= sizeof(metrics) / sizeof(metrics[0])) return;
+    Metric& metric = metrics[metricCount++];
+    strcpy(metric.name, fullName);
+    metric.value = value;
+    metric.higherIsBetter = higherIsBetter;
+    metric.checked = checked;
+}
+
+static void printResults() {
+    for (size_t i = 0; i < metricCount; ++i) {
+        printf("%-56s %14.1f\n", metrics[i].name, metrics[i].value);
+    }
+}
+
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* ----- Recorded responses ----- */
+
+static const char smallJsonResponse[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Mon, 12 May 2025 08:00:00 GMT\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 48\r\n"
+    "Connection: keep-alive\r\n"
+    "Server: nginx/1.24.0\r\n"
+    "Cache-Control: no-cache\r\n"
+    "\r\n"
+    "{\"sensor\":\"boiler\",\"temperature\":21.5,\"ok\":true}";
+
+static const size_t largeBodyLength = 16 * 1024;
+static const size_t chunkedBodyLength = 4 * 1024;
+static const size_t chunkSize = 256;
+
+static char largeResponse[largeBodyLength + 256];
+static char chunkedResponse[chunkedBodyLength + 1024];
+
+static void recordResponses() {
+    int length = snprintf(largeResponse, sizeof(largeResponse),
+        "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: %u\r\nConnection: keep-alive\r\n\r\n", (unsigned)largeBodyLength);
+    for (size_t i = 0; i < largeBodyLength; ++i) largeResponse[length + i] = 'a' + i % 26;
+    largeResponse[length + largeBodyLength] = '\0';
+
+    char* out = chunkedResponse;
+    out += sprintf(out, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\nConnection: keep-alive\r\n\r\n");
+    for (size_t sent = 0; sent < chunkedBodyLength; sent += chunkSize) {
+        out += sprintf(out, "%x\r\n", (unsigned)chunkSize);
+        for (size_t i = 0; i < chunkSize; ++i) *out++ = '0' + i % 10;
+        out += sprintf(out, "\r\n");
+    }
+    sprintf(out, "0\r\n\r\n");
+}
+
+/* ----- Micro benchmarks ----- */
+
+static void benchmarkParseUrl(size_t iterations) {
+    const char* url = "http://api.example.local:8080/v1/readings?sensor=boiler#latest";
+    volatile uint32_t sink = 0;
+
+    HeapStats before = heapStats();
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        ParsedUrl parsed = UrlParsing::parseUrl(url);
+        sink += parsed.port + parsed.path.length();
+    }
+    uint64_t elapsed = nowNs() - start;
+    HeapStats after = heapStats();
+
+    report("parseUrl", "ns_per_op", (double)elapsed / iterations);
+    report("parseUrl", "allocations_per_op", (double)(after.allocations - before.allocations) / iterations);
+
+    start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        UrlView view(url);
+        sink += view.port + view.targetLength();
+    }
+    elapsed = nowNs() - start;
+    report("urlView", "ns_per_op", (double)elapsed / iterations);
+    (void)sink;
+}
+
+static void benchmarkParseResponse(const char* scenario, const char* response, size_t expectedBodyLength, size_t iterations) {
+    String raw(response);
+    size_t received = 0;
+
+    HeapStats before = heapStats();
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        HttpResponse parsed = HttpResponseParsing::parseResponse(raw);
+        received += parsed.contentText.length();
+    }
+    uint64_t elapsed = nowNs() - start;
+    HeapStats after = heapStats();
+
+    if (received != expectedBodyLength * iterations) {
+        printf("  error: %s parsed %u instead of %u body bytes\n", scenario, (unsigned)(received / iterations), (unsigned)expectedBodyLength);
+        failed = true;
+    }
+
+    report(scenario, "ns_per_op", (double)elapsed / iterations);
+    report(scenario, "MB_per_s", (double)raw.length() * iterations * 1000.0 / elapsed, true);
+    report(scenario, "allocations_per_op", (double)(after.allocations - before.allocations) / iterations);
+    report(scenario, "bytes_allocated_per_op", (double)(after.bytesAllocated - before.bytesAllocated) / iterations);
+}
+
+/* ----- Request lifecycle ----- */
+
+static size_t completedRequests;
+static size_t failedRequests;
+static size_t expectedLength;
+
+static void onCompleted(HttpResponse& response) {
+    ++completedRequests;
+    if (response.status != HttpRequstStatus::Completed || response.responseCode != 200 || response.contentText.length() != expectedLength) {
+        ++failedRequests;
+    }
+}
+
+static uint32_t loopSamples[1 << 20];
+
+/**
+ * Sends requests in bursts of the given size and polls loop() until each burst is complete.
+ */
+static void benchmarkLifecycle(const char* scenario, const char* response, size_t bodyLength, size_t segmentSize, bool keepAlive, size_t burst, size_t requests) {
+    LoopbackServer& server = loopbackServer();
+    server = LoopbackServer();
+    server.response = response;
+    server.responseLength = strlen(response);
+    server.segmentSize = segmentSize;
+    server.keepAlive = keepAlive;
+
+    completedRequests = 0;
+    failedRequests = 0;
+    expectedLength = bodyLength;
+    size_t sampleCount = 0;
+    uint64_t loopTotal = 0;
+
+    BenchmarkHttp http;
+    http.setKeepAlive(keepAlive);
+
+    HeapStats before = heapStats();
+    heapStats().peak = before.current;
+
+    uint64_t start = nowNs();
+    for (size_t sent = 0; sent < requests; ) {
+        size_t target = completedRequests;
+        for (size_t i = 0; i < burst && sent < requests; ++i, ++sent) {
+            if (http.get("http://api.example.local/v1/readings", &onCompleted) == HttpRequstStatus::Sent) ++target;
+            else ++failedRequests;
+        }
+
+        for (size_t spins = 0; completedRequests < target; ++spins) {
+            if (spins > 1000000) {
+                printf("  error: %s stalled\n", scenario);
+                failed = true;
+                return;
+            }
+
+            ++server.tick;
+            uint64_t loopStart = nowNs();
+            http.loop();
+            uint64_t loopTime = nowNs() - loopStart;
+
+            loopTotal += loopTime;
+            if (sampleCount < sizeof(loopSamples) / sizeof(loopSamples[0])) {
+                loopSamples[sampleCount++] = (uint32_t)std::min<uint64_t>(loopTime, UINT32_MAX);
+            }
+        }
+    }
+    uint64_t elapsed = nowNs() - start;
+    HeapStats after = heapStats();
+
+    if (failedRequests > 0) {
+        printf("  error: %s had %u failed requests\n", scenario, (unsigned)failedRequests);
+        failed = true;
+    }
+
+    std::sort(loopSamples, loopSamples + sampleCount);
+
+    report(scenario, "requests_per_s", requests * 1e9 / elapsed, true);
+    report(scenario, "allocations_per_request", (double)(after.allocations - before.allocations) / requests);
+    report(scenario, "bytes_allocated_per_request", (double)(after.bytesAllocated - before.bytesAllocated) / requests);
+    report(scenario, "peak_heap_bytes", (double)(after.peak - before.current));
+    report(scenario, "connects", (double)server.connects);
+    report(scenario, "loop_calls_per_request", (double)sampleCount / requests);
+    report(scenario, "loop_mean_ns", sampleCount > 0 ? (double)loopTotal / sampleCount : 0);
+    report(scenario, "loop_p99_ns", sampleCount > 0 ? loopSamples[sampleCount * 99 / 100] : 0, false, false);
+    report(scenario, "loop_max_ns", sampleCount > 0 ? loopSamples[sampleCount - 1] : 0, false, false);
+}
+
+/* ----- Baseline ----- */
+
+static void saveBaseline(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        printf("error: cannot write %s\n", path);
+        failed = true;
+        return;
+    }
+    for (size_t i = 0; i < metricCount; ++i) {
+        fprintf(file, "%s %.3f\n", metrics[i].name, metrics[i].value);
+    }
+    fclose(file);
+    printf("\nbaseline written to %s\n", path);
+}
+
+/**
+ * Compares the results with a saved baseline. Timings depend on the machine, so a baseline should
+ * only be compared with runs on the same machine.
+ */
+static void compareBaseline(const char* path, double threshold) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        printf("error: cannot read %s\n", path);
+        failed = true;
+        return;
+    }
+
+    printf("\ncompared with %s (threshold %.0f%%)\n", path, threshold * 100);
+    size_t regressions = 0;
+    char name[64];
+    double baseline;
+    while (fscanf(file, "%63s %lf", name, &baseline) == 2) {
+        for (size_t i = 0; i < metricCount; ++i) {
+            Metric& metric = metrics[i];
+            if (!metric.checked || strcmp(metric.name, name) != 0) continue;
+
+            double change = baseline != 0 ? (metric.value - baseline) / baseline : (metric.value > 0 ? 1 : 0);
+            bool regressed = metric.higherIsBetter ? change < -threshold : change > threshold;
+            if (regressed) {
+                printf("  REGRESSION %-44s %14.1f -> %14.1f (%+.1f%%)\n", name, baseline, metric.value, change * 100);
+                ++regressions;
+            }
+        }
+    }
+    fclose(file);
+
+    if (regressions > 0) failed = true;
+    else printf("  no regressions\n");
+}
+
+int main(int argc, char** argv) {
+    const char* baselinePath = nullptr;
+    const char* savePath = nullptr;
+    double threshold = 0.10;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) savePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]) / 100;
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = atoi(argv[++i]);
+        else {
+            printf("usage: %s [--baseline FILE] [--save FILE] [--threshold PERCENT] [--repeat COUNT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    recordResponses();
+    size_t smallBodyLength = strlen(strstr(smallJsonResponse, "\r\n\r\n") + 4);
+
+    for (int run = 0; run < repeat; ++run) {
+        benchmarkParseUrl(200000);
+        benchmarkParseResponse("parseResponse.smallJson", smallJsonResponse, smallBodyLength, 100000);
+        benchmarkParseResponse("parseResponse.large", largeResponse, largeBodyLength, 2000);
+        benchmarkParseResponse("parseResponse.chunked", chunkedResponse, chunkedBodyLength, 10000);
+
+        benchmarkLifecycle("request.smallJson", smallJsonResponse, smallBodyLength, 0, false, 1, 20000);
+        benchmarkLifecycle("request.smallJson.keepAlive", smallJsonResponse, smallBodyLength, 0, true, 1, 20000);
+        benchmarkLifecycle("request.smallJson.burst", smallJsonResponse, smallBodyLength, 0, true, DEFAULT_MAX_CLIENTS, 20000);
+        benchmarkLifecycle("request.large", largeResponse, largeBodyLength, 1460, true, 1, 1000);
+        benchmarkLifecycle("request.chunked", chunkedResponse, chunkedBodyLength, 1460, true, 1, 5000);
+        benchmarkLifecycle("request.slowDrip", smallJsonResponse, smallBodyLength, 7, true, 1, 5000);
+    }
+    printResults();
+
+    if (baselinePath != nullptr) compareBaseline(baselinePath, threshold);
+    if (savePath != nullptr) saveBaseline(savePath);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: Arduino.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+/**
+ * Minimal host-side replacement for the Arduino core, just enough to compile the library on Linux.
+ * String follows the allocation behaviour of ArduinoCore-API (AVR, SAMD, megaAVR, mbed): every string
+ * owns a heap buffer (even an empty one) that is resized to the exact length on every concatenation.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <chrono>
+#include "HeapTracking.h"
+
+inline unsigned long millis() {
+    static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long micros() {
+    static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline void delay(unsigned long) {}
+inline void yield() {}
+
+class String {
+public:
+    String(const char* cstr = "") {
+        init();
+        if (cstr) copy(cstr, strlen(cstr));
+    }
+
+    String(const String& other) {
+        init();
+        copy(other.c_str(), other.len);
+    }
+
+    String(String&& other) {
+        buffer = other.buffer;
+        capacity = other.capacity;
+        len = other.len;
+        other.init();
+    }
+
+    explicit String(char c) {
+        init();
+        copy(&c, 1);
+    }
+
+    explicit String(int value) { initNumber("%d", value); }
+    explicit String(unsigned int value) { initNumber("%u", value); }
+    explicit String(long value) { initNumber("%ld", value); }
+    explicit String(unsigned long value) { initNumber("%lu", value); }
+
+    ~String() {
+        heapFree(buffer);
+    }
+
+    String& operator=(const String& other) {
+        if (this != &other) copy(other.c_str(), other.len);
+        return *this;
+    }
+
+    String& operator=(String&& other) {
+        if (this != &other) {
+            heapFree(buffer);
+            buffer = other.buffer;
+            capacity = other.capacity;
+            len = other.len;
+            other.init();
+        }
+        return *this;
+    }
+
+    String& operator=(const char* cstr) {
+        copy(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+        return *this;
+    }
+
+    unsigned int length() const { return len; }
+    const char* c_str() const { return buffer ? buffer : ""; }
+    char operator[](unsigned int index) const { return index < len ? buffer[index] : 0; }
+    char& operator[](unsigned int index) { return buffer[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    bool reserve(unsigned int size) {
+        if (buffer && capacity >= size) return true;
+        char* newBuffer = (char*)heapRealloc(buffer, size + 1);
+        if (newBuffer == nullptr) return false;
+        if (buffer == nullptr) newBuffer[0] = '\0';
+        buffer = newBuffer;
+        capacity = size;
+        return true;
+    }
+
+    bool concat(const char* cstr, unsigned int length) {
+        if (cstr == nullptr) return false;
+        if (length == 0) return true;
+        if (!reserve(len + length)) return false;
+        memmove(buffer + len, cstr, length);
+        len += length;
+        buffer[len] = '\0';
+        return true;
+    }
+
+    bool concat(const String& other) { return concat(other.c_str(), other.len); }
+    bool concat(const char* cstr) { return cstr ? concat(cstr, strlen(cstr)) : false; }
+    bool concat(char c) { return concat(&c, 1); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+
+    String& operator+=(const String& other) { concat(other); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    friend String operator+(const String& a, const String& b) { String result(a); result += b; return result; }
+    friend String operator+(const String& a, const char* b) { String result(a); result += b; return result; }
+
+    bool equals(const String& other) const { return len == other.len && strcmp(c_str(), other.c_str()) == 0; }
+    bool equals(const char* cstr) const { return strcmp(c_str(), cstr) == 0; }
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool equalsIgnoreCase(const String& other) const { return len == other.len && strcasecmp(c_str(), other.c_str()) == 0; }
+
+    bool startsWith(const String& prefix) const {
+        return prefix.len <= len && strncmp(c_str(), prefix.c_str(), prefix.len) == 0;
+    }
+
+    bool endsWith(const String& suffix) const {
+        return suffix.len <= len && strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        if (from >= len) return -1;
+        const char* found = strchr(c_str() + from, c);
+        return found ? (int)(found - c_str()) : -1;
+    }
+
+    int indexOf(const String& other, unsigned int from = 0) const {
+        if (from >= len) return -1;
+        const char* found = strstr(c_str() + from, other.c_str());
+        return found ? (int)(found - c_str()) : -1;
+    }
+
+    String substring(unsigned int begin) const { return substring(begin, len); }
+
+    String substring(unsigned int begin, unsigned int end) const {
+        if (begin > end) { unsigned int swap = begin; begin = end; end = swap; }
+        String result;
+        if (begin >= len) return result;
+        if (end > len) end = len;
+        result.concat(c_str() + begin, end - begin);
+        return result;
+    }
+
+    long toInt() const { return atol(c_str()); }
+
+    void trim() {
+        if (len == 0) return;
+        unsigned int begin = 0;
+        while (begin < len && isSpace(buffer[begin])) ++begin;
+        unsigned int end = len;
+        while (end > begin && isSpace(buffer[end - 1])) --end;
+        len = end - begin;
+        if (begin > 0) memmove(buffer, buffer + begin, len);
+        buffer[len] = '\0';
+    }
+
+    void toLowerCase() {
+        for (unsigned int i = 0; i < len; ++i) {
+            if (buffer[i] >= 'A' && buffer[i] <= 'Z') buffer[i] += 'a' - 'A';
+        }
+    }
+
+private:
+    char* buffer;
+    unsigned int capacity;
+    unsigned int len;
+
+    void init() {
+        buffer = nullptr;
+        capacity = 0;
+        len = 0;
+    }
+
+    void copy(const char* cstr, unsigned int length) {
+        if (!reserve(length)) return;
+        memmove(buffer, cstr, length);
+        len = length;
+        buffer[len] = '\0';
+    }
+
+    template <typename T>
+    void initNumber(const char* format, T value) {
+        char digits[24];
+        snprintf(digits, sizeof(digits), format, value);
+        init();
+        copy(digits, strlen(digits));
+    }
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+    }
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t count = 0;
+        while (size--) count += write(*buffer++);
+        return count;
+    }
+
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write((const uint8_t*)str.c_str(), str.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned long value) { return print(String(value)); }
+    size_t print(int value) { return print(String(value)); }
+    size_t println() { return write("\r\n"); }
+    size_t println(const char* str) { return print(str) + println(); }
+    size_t println(const String& str) { return print(str) + println(); }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { this->timeout = timeout; }
+    unsigned long getTimeout() const { return timeout; }
+
+    size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+protected:
+    unsigned long timeout = 1000;
+};
+
+#include "IPAddress.h"
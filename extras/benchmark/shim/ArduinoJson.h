@@ -0,0 +1,74 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: ArduinoJson.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+/**
+ * Stand-in for ArduinoJson with the functions the library calls. Documents only hold their raw
+ * text, which is all the benchmark needs to drive requests with JSON bodies.
+ */
+
+#include "Arduino.h"
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory };
+
+    DeserializationError(Code code = Ok) : errorCode(code) {}
+    explicit operator bool() const { return errorCode != Ok; }
+    Code code() const { return errorCode; }
+    const char* c_str() const { return errorCode == Ok ? "Ok" : "Error"; }
+
+private:
+    Code errorCode;
+};
+
+class JsonDocument {
+public:
+    String raw;
+    void clear() { raw = String(); }
+};
+
+namespace DeserializationOption {
+    struct Filter {
+        explicit Filter(const JsonDocument& filter) : document(&filter) {}
+        const JsonDocument* document;
+    };
+}
+
+inline size_t measureJson(const JsonDocument& document) {
+    return document.raw.length();
+}
+
+inline size_t serializeJson(const JsonDocument& document, String& output) {
+    output = document.raw;
+    return document.raw.length();
+}
+
+inline size_t serializeJson(const JsonDocument& document, Print& output) {
+    return output.print(document.raw);
+}
+
+inline DeserializationError deserializeJson(JsonDocument& document, const String& input) {
+    document.raw = input;
+    return input.length() > 0 ? DeserializationError::Ok : DeserializationError::EmptyInput;
+}
+
+inline DeserializationError deserializeJson(JsonDocument& document, Stream& input) {
+    document.raw = String();
+    int c;
+    while ((c = input.read()) >= 0) document.raw.concat((char)c);
+    return document.raw.length() > 0 ? DeserializationError::Ok : DeserializationError::EmptyInput;
+}
+
+inline DeserializationError deserializeJson(JsonDocument& document, Stream& input, DeserializationOption::Filter) {
+    return deserializeJson(document, input);
+}
@@ -0,0 +1,79 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HeapTracking.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * Counts every allocation made through the String shim and the global operator new, so the
+ * benchmark can report allocations, allocated bytes and peak heap use like on a board.
+ */
+struct HeapStats {
+    size_t allocations;
+    size_t frees;
+    size_t bytesAllocated;
+    size_t current;
+    size_t peak;
+};
+
+inline HeapStats& heapStats() {
+    static HeapStats stats = HeapStats();
+    return stats;
+}
+
+// Every block is prefixed with its size, so frees and reallocations can be accounted for.
+union HeapBlockHeader {
+    size_t size;
+    max_align_t align;
+};
+
+inline void heapTrackAllocation(size_t size) {
+    HeapStats& stats = heapStats();
+    ++stats.allocations;
+    stats.bytesAllocated += size;
+    stats.current += size;
+    if (stats.current > stats.peak) stats.peak = stats.current;
+}
+
+inline void* heapAlloc(size_t size) {
+    HeapBlockHeader* header = (HeapBlockHeader*)malloc(sizeof(HeapBlockHeader) + size);
+    if (header == nullptr) return nullptr;
+    header->size = size;
+    heapTrackAllocation(size);
+    return header + 1;
+}
+
+inline void heapFree(void* block) {
+    if (block == nullptr) return;
+    HeapBlockHeader* header = (HeapBlockHeader*)block - 1;
+    HeapStats& stats = heapStats();
+    ++stats.frees;
+    stats.current -= header->size;
+    free(header);
+}
+
+// Behaves like realloc(): a reallocation is counted as one allocation of the new size.
+inline void* heapRealloc(void* block, size_t size) {
+    if (block == nullptr) return heapAlloc(size);
+
+    HeapBlockHeader* header = (HeapBlockHeader*)block - 1;
+    size_t oldSize = header->size;
+    header = (HeapBlockHeader*)realloc(header, sizeof(HeapBlockHeader) + size);
+    if (header == nullptr) return nullptr;
+    header->size = size;
+
+    HeapStats& stats = heapStats();
+    stats.current -= oldSize;
+    heapTrackAllocation(size);
+    return header + 1;
+}
@@ -0,0 +1,155 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: CodecVectors.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+/**
+ * Compressed streams for the codec tests. The text streams were produced by zlib (level 9, 512 byte
+ * window, dynamic Huffman codes) and Python's gzip module (stored block, with a file name). The long
+ * distance stream was assembled by hand: its only reference back to the start of the data is 26000
+ * bytes long and uses a 15 bit distance code followed by 13 extra bits.
+ */
+
+// 24 lines of JSON, the content of all text streams
+inline std::string codecText() {
+    std::string text;
+    char line[96];
+    for (int i = 0; i < 24; ++i) {
+        snprintf(line, sizeof(line), "{\"id\":%d,\"name\":\"sensor-%d\",\"value\":%d,\"unit\":\"celsius\"}\n", i, i % 5, (i * 37) % 101);
+        text += line;
+    }
+    return text;
+}
+
+// A marker, 25976 zero bytes, the marker again and "end", the content of longDistanceZlib
+inline std::string codecLongDistanceText() {
+    std::string marker = "MARKER-0123456789-LONG!!";
+    return marker + std::string(26000 - marker.size(), '\0') + marker + "end";
+}
+
+static const uint8_t textGzip[232] = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7D, 0xCF, 0x4B, 0x0A, 0xC2, 0x40, 0x10, 0x84, 0xE1, 0xBD, 0xC7, 0x98, 0x75, 0x84,
+    0xE9, 0x47, 0x32, 0x89, 0xB7, 0x11, 0xCD, 0x22, 0xA0, 0x11, 0x8C, 0x71, 0x13, 0xBC, 0xBB, 0xE2, 0xA6, 0xA4, 0xB0, 0x67, 0x5D, 0x7C, 0xF4, 0xDF,
+    0x5B, 0x9A, 0xCE, 0xE9, 0x90, 0x9B, 0x34, 0x1F, 0xAF, 0x63, 0x3A, 0xA4, 0x65, 0x9C, 0x97, 0xDB, 0x7D, 0x9F, 0x53, 0x93, 0x9E, 0xC7, 0xCB, 0x3A,
+    0x7E, 0xB7, 0x75, 0x9E, 0x1E, 0x9F, 0xED, 0x34, 0x5E, 0x96, 0x69, 0x5D, 0xD2, 0x6B, 0xB7, 0x7D, 0x95, 0xB0, 0x12, 0x28, 0x2B, 0x21, 0x53, 0x66,
+    0x0A, 0x56, 0x3C, 0x64, 0xC6, 0xCC, 0xC0, 0x24, 0x8E, 0x74, 0x66, 0x0E, 0xE6, 0x71, 0x64, 0xCB, 0x2C, 0x83, 0xF5, 0x71, 0x64, 0xC7, 0x4C, 0xC0,
+    0x34, 0x8E, 0x2C, 0xCC, 0x14, 0xAC, 0x8D, 0x23, 0x7B, 0x66, 0x06, 0x36, 0xC4, 0x91, 0x03, 0x33, 0x07, 0xB3, 0x38, 0x52, 0x32, 0xBB, 0x0C, 0xD7,
+    0xC5, 0x95, 0x22, 0xEC, 0xE4, 0xE7, 0x5E, 0xCC, 0x94, 0x99, 0x82, 0x79, 0x25, 0xD3, 0xD8, 0x19, 0x5C, 0xA9, 0x64, 0x3A, 0x3B, 0x87, 0x93, 0x4A,
+    0x67, 0xCB, 0x2E, 0xC3, 0xB5, 0x95, 0xCE, 0x8E, 0x9D, 0xC0, 0xF5, 0x95, 0xCE, 0xC2, 0x4E, 0xE1, 0xB4, 0xD2, 0xD9, 0xB3, 0x33, 0xB8, 0xAE, 0xD2,
+    0x39, 0xB0, 0x73, 0xB8, 0x21, 0xEE, 0xD4, 0xCC, 0x2E, 0xC3, 0x59, 0xDC, 0xA9, 0xC2, 0x4E, 0xE0, 0x4A, 0xDC, 0xA9, 0xCA, 0x4E, 0x7F, 0xFE, 0x8B,
+    0x99, 0x31, 0x33, 0x30, 0xFF, 0x97, 0xF9, 0x06, 0x7D, 0x67, 0xA5, 0x05, 0x33, 0x05, 0x00, 0x00
+};
+
+static const uint8_t textZlib[220] = {
+    0x18, 0xD3, 0x7D, 0xCF, 0x4B, 0x0A, 0xC2, 0x40, 0x10, 0x84, 0xE1, 0xBD, 0xC7, 0x98, 0x75, 0x84, 0xE9, 0x47, 0x32, 0x89, 0xB7, 0x11, 0xCD, 0x22,
+    0xA0, 0x11, 0x8C, 0x71, 0x13, 0xBC, 0xBB, 0xE2, 0xA6, 0xA4, 0xB0, 0x67, 0x5D, 0x7C, 0xF4, 0xDF, 0x5B, 0x9A, 0xCE, 0xE9, 0x90, 0x9B, 0x34, 0x1F,
+    0xAF, 0x63, 0x3A, 0xA4, 0x65, 0x9C, 0x97, 0xDB, 0x7D, 0x9F, 0x53, 0x93, 0x9E, 0xC7, 0xCB, 0x3A, 0x7E, 0xB7, 0x75, 0x9E, 0x1E, 0x9F, 0xED, 0x34,
+    0x5E, 0x96, 0x69, 0x5D, 0xD2, 0x6B, 0xB7, 0x7D, 0x95, 0xB0, 0x12, 0x28, 0x2B, 0x21, 0x53, 0x66, 0x0A, 0x56, 0x3C, 0x64, 0xC6, 0xCC, 0xC0, 0x24,
+    0x8E, 0x74, 0x66, 0x0E, 0xE6, 0x71, 0x64, 0xCB, 0x2C, 0x83, 0xF5, 0x71, 0x64, 0xC7, 0x4C, 0xC0, 0x34, 0x8E, 0x2C, 0xCC, 0x14, 0xAC, 0x8D, 0x23,
+    0x7B, 0x66, 0x06, 0x36, 0xC4, 0x91, 0x03, 0x33, 0x07, 0xB3, 0x38, 0x52, 0x32, 0xBB, 0x0C, 0xD7, 0xC5, 0x95, 0x22, 0xEC, 0xE4, 0xE7, 0x5E, 0xCC,
+    0x94, 0x99, 0x82, 0x79, 0x25, 0xD3, 0xD8, 0x19, 0x5C, 0xA9, 0x64, 0x3A, 0x3B, 0x87, 0x93, 0x4A, 0x67, 0xCB, 0x2E, 0xC3, 0xB5, 0x95, 0xCE, 0x8E,
+    0x9D, 0xC0, 0xF5, 0x95, 0xCE, 0xC2, 0x4E, 0xE1, 0xB4, 0xD2, 0xD9, 0xB3, 0x33, 0xB8, 0xAE, 0xD2, 0x39, 0xB0, 0x73, 0xB8, 0x21, 0xEE, 0xD4, 0xCC,
+    0x2E, 0xC3, 0x59, 0xDC, 0xA9, 0xC2, 0x4E, 0xE0, 0x4A, 0xDC, 0xA9, 0xCA, 0x4E, 0x7F, 0xFE, 0x8B, 0x99, 0x31, 0x33, 0x30, 0xFF, 0x97, 0xF9, 0x06,
+    0x7D, 0x0A, 0x96, 0xFA
+};
+
+static const uint8_t textRaw[214] = {
+    0x7D, 0xCF, 0x4B, 0x0A, 0xC2, 0x40, 0x10, 0x84, 0xE1, 0xBD, 0xC7, 0x98, 0x75, 0x84, 0xE9, 0x47, 0x32, 0x89, 0xB7, 0x11, 0xCD, 0x22, 0xA0, 0x11,
+    0x8C, 0x71, 0x13, 0xBC, 0xBB, 0xE2, 0xA6, 0xA4, 0xB0, 0x67, 0x5D, 0x7C, 0xF4, 0xDF, 0x5B, 0x9A, 0xCE, 0xE9, 0x90, 0x9B, 0x34, 0x1F, 0xAF, 0x63,
+    0x3A, 0xA4, 0x65, 0x9C, 0x97, 0xDB, 0x7D, 0x9F, 0x53, 0x93, 0x9E, 0xC7, 0xCB, 0x3A, 0x7E, 0xB7, 0x75, 0x9E, 0x1E, 0x9F, 0xED, 0x34, 0x5E, 0x96,
+    0x69, 0x5D, 0xD2, 0x6B, 0xB7, 0x7D, 0x95, 0xB0, 0x12, 0x28, 0x2B, 0x21, 0x53, 0x66, 0x0A, 0x56, 0x3C, 0x64, 0xC6, 0xCC, 0xC0, 0x24, 0x8E, 0x74,
+    0x66, 0x0E, 0xE6, 0x71, 0x64, 0xCB, 0x2C, 0x83, 0xF5, 0x71, 0x64, 0xC7, 0x4C, 0xC0, 0x34, 0x8E, 0x2C, 0xCC, 0x14, 0xAC, 0x8D, 0x23, 0x7B, 0x66,
+    0x06, 0x36, 0xC4, 0x91, 0x03, 0x33, 0x07, 0xB3, 0x38, 0x52, 0x32, 0xBB, 0x0C, 0xD7, 0xC5, 0x95, 0x22, 0xEC, 0xE4, 0xE7, 0x5E, 0xCC, 0x94, 0x99,
+    0x82, 0x79, 0x25, 0xD3, 0xD8, 0x19, 0x5C, 0xA9, 0x64, 0x3A, 0x3B, 0x87, 0x93, 0x4A, 0x67, 0xCB, 0x2E, 0xC3, 0xB5, 0x95, 0xCE, 0x8E, 0x9D, 0xC0,
+    0xF5, 0x95, 0xCE, 0xC2, 0x4E, 0xE1, 0xB4, 0xD2, 0xD9, 0xB3, 0x33, 0xB8, 0xAE, 0xD2, 0x39, 0xB0, 0x73, 0xB8, 0x21, 0xEE, 0xD4, 0xCC, 0x2E, 0xC3,
+    0x59, 0xDC, 0xA9, 0xC2, 0x4E, 0xE0, 0x4A, 0xDC, 0xA9, 0xCA, 0x4E, 0x7F, 0xFE, 0x8B, 0x99, 0x31, 0x33, 0x30, 0xFF, 0x97, 0xF9, 0x06
+};
+
+static const uint8_t textGzipStored[1364] = {
+    0x1F, 0x8B, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x62, 0x6F, 0x64, 0x79, 0x2E, 0x6A, 0x73, 0x6F, 0x6E, 0x00, 0x01, 0x33, 0x05, 0xCC,
+    0xFA, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x30, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D,
+    0x30, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C,
+    0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73,
+    0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x31, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x33, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69,
+    0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x32, 0x2C, 0x22, 0x6E,
+    0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x32, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A,
+    0x37, 0x34, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69,
+    0x64, 0x22, 0x3A, 0x33, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x33, 0x22, 0x2C, 0x22,
+    0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x31, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75,
+    0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x34, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73,
+    0x6F, 0x72, 0x2D, 0x34, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x34, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A,
+    0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x35, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65,
+    0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x30, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x38, 0x34, 0x2C,
+    0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A,
+    0x36, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x31, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C,
+    0x75, 0x65, 0x22, 0x3A, 0x32, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D,
+    0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x37, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D,
+    0x32, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x35, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65,
+    0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x38, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22,
+    0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x33, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x39, 0x34, 0x2C, 0x22, 0x75, 0x6E,
+    0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x39, 0x2C, 0x22,
+    0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x34, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22,
+    0x3A, 0x33, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22,
+    0x69, 0x64, 0x22, 0x3A, 0x31, 0x30, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x30, 0x22,
+    0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x36, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73,
+    0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x31, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73,
+    0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x31, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x33, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74,
+    0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x32, 0x2C, 0x22, 0x6E,
+    0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x32, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A,
+    0x34, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69,
+    0x64, 0x22, 0x3A, 0x31, 0x33, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x33, 0x22, 0x2C,
+    0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x37, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69,
+    0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x34, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65,
+    0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x34, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x31, 0x33, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74,
+    0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x35, 0x2C, 0x22, 0x6E,
+    0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x30, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A,
+    0x35, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69,
+    0x64, 0x22, 0x3A, 0x31, 0x36, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x31, 0x22, 0x2C,
+    0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x38, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69,
+    0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x37, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65,
+    0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x32, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x32, 0x33, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74,
+    0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x31, 0x38, 0x2C, 0x22, 0x6E,
+    0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x33, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A,
+    0x36, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69,
+    0x64, 0x22, 0x3A, 0x31, 0x39, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x34, 0x22, 0x2C,
+    0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x39, 0x37, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69,
+    0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x32, 0x30, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65,
+    0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x30, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x33, 0x33, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74,
+    0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x32, 0x31, 0x2C, 0x22, 0x6E,
+    0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x31, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A,
+    0x37, 0x30, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69,
+    0x64, 0x22, 0x3A, 0x32, 0x32, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E, 0x73, 0x6F, 0x72, 0x2D, 0x32, 0x22, 0x2C,
+    0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x36, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22, 0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75,
+    0x73, 0x22, 0x7D, 0x0A, 0x7B, 0x22, 0x69, 0x64, 0x22, 0x3A, 0x32, 0x33, 0x2C, 0x22, 0x6E, 0x61, 0x6D, 0x65, 0x22, 0x3A, 0x22, 0x73, 0x65, 0x6E,
+    0x73, 0x6F, 0x72, 0x2D, 0x33, 0x22, 0x2C, 0x22, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x22, 0x3A, 0x34, 0x33, 0x2C, 0x22, 0x75, 0x6E, 0x69, 0x74, 0x22,
+    0x3A, 0x22, 0x63, 0x65, 0x6C, 0x73, 0x69, 0x75, 0x73, 0x22, 0x7D, 0x0A, 0x7D, 0x67, 0xA5, 0x05, 0x33, 0x05, 0x00, 0x00
+};
+
+static const uint8_t longDistanceZlib[321] = {
+    0x78, 0x9C, 0xED, 0xFD, 0x01, 0x90, 0x24, 0x49, 0x92, 0x24, 0x49, 0x46, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+    0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+    0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+    0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x64, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0xBA, 0xBB, 0xBB, 0xBB, 0xBB,
+    0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0x47, 0x44, 0x44, 0x20, 0xB1, 0xA8, 0x79, 0x64, 0xF5, 0xEC, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xFB, 0x3A, 0x06, 0x79, 0xBB, 0x06, 0xE9, 0x1A, 0x18, 0x1A, 0x19, 0x9B, 0x98, 0x9A, 0x99, 0x5B, 0x58, 0xEA, 0xFA, 0xF8, 0xFB, 0xB9, 0x2B,
+    0x2A, 0x32, 0x4C, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69,
+    0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D,
+    0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49,
+    0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69,
+    0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0xA4, 0x49, 0x93, 0x26, 0x4D, 0x9A, 0x34, 0x69, 0xD2, 0x18, 0x83, 0xEB, 0xFF, 0xFF,
+    0x58, 0x52, 0xF3, 0x52, 0x00, 0x8B, 0xBA, 0x0C, 0x6E
+};
@@ -0,0 +1,401 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: codec_test.cpp
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+/**
+ * Host-side tests of the gzip and deflate codecs. The inflater is checked against streams produced
+ * by zlib, fed whole, split at every position and byte by byte, and against corrupted streams. The
+ * deflater is checked by inflating what it produced, including chunked request bodies larger than
+ * a single chunk. See README.md.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "HttpDeflater.h"
+#include "HttpInflater.h"
+#include "HttpRequestWriter.h"
+#include "HttpResponseParsing.h"
+#include "CodecVectors.h"
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(bool condition, const char* expression, const char* test, int line) {
+    ++checks;
+    if (condition) return;
+    ++failures;
+    printf("FAILED %s (line %d): %s\n", test, line, expression);
+}
+
+#define CHECK(condition) check((condition), #condition, __func__, __LINE__)
+
+struct Vector {
+    const char* name;
+    HttpContentEncoding encoding;
+    const uint8_t* data;
+    size_t length;
+    std::string expected;
+};
+
+static std::vector<Vector> vectors() {
+    std::vector<Vector> result;
+    result.push_back({"textGzip", EncodingGzip, textGzip, sizeof(textGzip), codecText()});
+    result.push_back({"textZlib", EncodingDeflate, textZlib, sizeof(textZlib), codecText()});
+    result.push_back({"textRaw", EncodingDeflate, textRaw, sizeof(textRaw), codecText()});
+    result.push_back({"textGzipStored", EncodingGzip, textGzipStored, sizeof(textGzipStored), codecText()});
+    result.push_back({"longDistanceZlib", EncodingDeflate, longDistanceZlib, sizeof(longDistanceZlib), codecLongDistanceText()});
+    return result;
+}
+
+/* ----- Inflater ----- */
+
+struct InflateResult {
+    std::string output;
+    bool stalled;
+    bool done;
+    bool failed;
+};
+
+// Passes one slice to the inflater the way the response parser does: until it is consumed and the window is drained
+static void feed(HttpInflater& inflater, InflateResult& result, const uint8_t* data, size_t length) {
+    size_t consumed = 0;
+    do {
+        const char* output;
+        size_t outputLength;
+        size_t used = inflater.inflate(data + consumed, length - consumed, output, outputLength);
+        consumed += used;
+        result.output.append(output, outputLength);
+        if (used == 0 && outputLength == 0 && consumed < length) {
+            result.stalled = true;
+            return;
+        }
+    } while (!inflater.hasFailed() && (consumed < length || inflater.isOutputPending()));
+}
+
+// Inflates a stream passed in slices of sliceLength bytes, the first one ending at split
+static InflateResult inflateSlices(HttpContentEncoding encoding, const uint8_t* data, size_t length, size_t split, size_t sliceLength) {
+    HttpInflater inflater(encoding);
+    InflateResult result = InflateResult();
+    size_t position = 0;
+    while (position < length && !result.stalled) {
+        size_t end = position == 0 && split > 0 ? split : position + sliceLength;
+        if (end > length) end = length;
+        feed(inflater, result, data + position, end - position);
+        position = end;
+    }
+    result.done = inflater.isDone();
+    result.failed = inflater.hasFailed();
+    return result;
+}
+
+static InflateResult inflateAll(HttpContentEncoding encoding, const uint8_t* data, size_t length) {
+    return inflateSlices(encoding, data, length, 0, length);
+}
+
+// Whether a vector can be inflated with the configured window
+static bool fitsWindow(const Vector& vector) {
+    return vector.expected.size() < 26000 || HTTP_INFLATE_WINDOW_BITS == 15;
+}
+
+static void testWholeStreams() {
+    std::vector<Vector> all = vectors();
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Vector& vector = all[i];
+        InflateResult result = inflateAll(vector.encoding, vector.data, vector.length);
+        CHECK(!result.stalled);
+        if (fitsWindow(vector)) {
+            CHECK(result.done && !result.failed);
+            CHECK(result.output == vector.expected);
+        }
+        else {
+            // a reference past the window fails instead of producing wrong bytes
+            CHECK(result.failed);
+        }
+    }
+}
+
+static void testSplitAtEveryPosition() {
+    std::vector<Vector> all = vectors();
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Vector& vector = all[i];
+        if (!fitsWindow(vector)) continue;
+
+        for (size_t split = 1; split < vector.length; ++split) {
+            InflateResult result = inflateSlices(vector.encoding, vector.data, vector.length, split, vector.length);
+            CHECK(!result.stalled && result.done);
+            CHECK(result.output == vector.expected);
+        }
+
+        InflateResult result = inflateSlices(vector.encoding, vector.data, vector.length, 0, 1);
+        CHECK(!result.stalled && result.done);
+        CHECK(result.output == vector.expected);
+    }
+}
+
+static void testCorruptStreams() {
+    std::vector<uint8_t> data(textGzip, textGzip + sizeof(textGzip));
+
+    // CRC-32 and length at the end of the gzip stream
+    data[data.size() - 8] ^= 0x01;
+    InflateResult result = inflateAll(EncodingGzip, data.data(), data.size());
+    CHECK(result.failed && !result.done);
+    data[data.size() - 8] ^= 0x01;
+    data[data.size() - 4] ^= 0x01;
+    result = inflateAll(EncodingGzip, data.data(), data.size());
+    CHECK(result.failed && !result.done);
+
+    // Adler-32 at the end of the zlib stream
+    std::vector<uint8_t> zlibData(textZlib, textZlib + sizeof(textZlib));
+    zlibData.back() ^= 0x80;
+    result = inflateAll(EncodingDeflate, zlibData.data(), zlibData.size());
+    CHECK(result.failed && !result.done);
+
+    // every flipped bit of the compressed data either fails or still produces the original text
+    std::string expected = codecText();
+    for (size_t i = 2; i + 4 < sizeof(textZlib); ++i) {
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            std::vector<uint8_t> flipped(textZlib, textZlib + sizeof(textZlib));
+            flipped[i] ^= 1 << bit;
+            result = inflateSlices(EncodingDeflate, flipped.data(), flipped.size(), 0, 7);
+            CHECK(!result.stalled);
+            CHECK(!result.done || result.output == expected);
+        }
+    }
+
+    // a stream that ends early is neither done nor failed
+    result = inflateAll(EncodingGzip, textGzip, sizeof(textGzip) - 4);
+    CHECK(!result.done && !result.failed && !result.stalled);
+
+    // garbage
+    std::vector<uint8_t> garbage(64, 0xFF);
+    result = inflateAll(EncodingGzip, garbage.data(), garbage.size());
+    CHECK(result.failed);
+    result = inflateAll(EncodingDeflate, garbage.data(), garbage.size());
+    CHECK(result.failed);
+}
+
+/* ----- Response parser ----- */
+
+static std::string response(const char* framing, const uint8_t* body, size_t length, bool chunked) {
+    std::string text = "HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n";
+    text += framing;
+    text += "\r\n\r\n";
+    if (!chunked) return text + std::string((const char*)body, length);
+
+    // chunks of 100 bytes
+    for (size_t position = 0; position < length; position += 100) {
+        size_t chunkLength = length - position < 100 ? length - position : 100;
+        char size[16];
+        snprintf(size, sizeof(size), "%x\r\n", (unsigned)chunkLength);
+        text += size;
+        text.append((const char*)body + position, chunkLength);
+        text += "\r\n";
+    }
+    return text + "0\r\n\r\n";
+}
+
+// Passes a response to a parser in two parts and collects the body, in pull mode slice by slice
+static std::string parse(HttpResponseParser& parser, const std::string& text, size_t split, bool pull) {
+    parser.reset();
+    parser.setDecompress(true);
+    parser.setPullBody(pull);
+
+    std::string body;
+    size_t position = 0;
+    size_t end = split;
+    for (int calls = 0; !parser.isDone() && calls < 100000; ++calls) {
+        size_t consumed = parser.consume(text.data() + position, end - position);
+        position += consumed;
+        size_t sliceLength;
+        const char* slice = parser.getBodySlice(sliceLength);
+        body.append(slice, sliceLength);
+        if (position == end && !parser.hasPendingBody()) {
+            if (end == text.size()) break;
+            end = text.size();
+        }
+    }
+    if (!pull) body = parser.response.contentText.c_str();
+    return body;
+}
+
+static void testParser() {
+    std::string expected = codecText();
+    std::string texts[] = {
+        response("Content-Length: 232", textGzip, sizeof(textGzip), false),
+        response("Transfer-Encoding: chunked", textGzip, sizeof(textGzip), true),
+    };
+
+    HttpResponseParser parser;
+    for (size_t t = 0; t < 2; ++t) {
+        const std::string& text = texts[t];
+        for (size_t split = 1; split <= text.size(); ++split) {
+            std::string body = parse(parser, text, split, false);
+            CHECK(parser.isDone() && !parser.response.decompressionFailed);
+            CHECK(body == expected);
+
+            body = parse(parser, text, split, true);
+            CHECK(parser.isDone() && !parser.response.decompressionFailed);
+            CHECK(body == expected);
+        }
+    }
+
+    // a body that ends before the compressed stream is incomplete
+    std::string truncated = response("Content-Length: 200", textGzip, 200, false);
+    parse(parser, truncated, truncated.size(), false);
+    CHECK(parser.isDone() && parser.response.decompressionFailed);
+
+    // a body that cannot be inflated is dropped
+    std::vector<uint8_t> garbage(64, 0xFF);
+    std::string broken = response("Content-Length: 64", garbage.data(), garbage.size(), false);
+    std::string body = parse(parser, broken, broken.size(), false);
+    CHECK(parser.isDone() && parser.response.decompressionFailed && body.empty());
+}
+
+/* ----- Deflater ----- */
+
+// Collects what is written to it, like a client would send it
+class StringPrint : public Print {
+    public:
+        std::string text;
+
+        size_t write(uint8_t c) override {
+            text += (char)c;
+            return 1;
+        }
+
+        size_t write(const uint8_t* data, size_t length) override {
+            text.append((const char*)data, length);
+            return length;
+        }
+};
+
+// Bytes that do not compress, so the compressed body is larger than its input
+static std::string noise(size_t length) {
+    std::string result(length, 0);
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < length; ++i) {
+        state = state * 1664525UL + 1013904223UL;
+        result[i] = (char)(state >> 24);
+    }
+    return result;
+}
+
+static std::string deflate(const std::string& input, size_t writeLength) {
+    StringPrint out;
+    HttpDeflater deflater(out);
+    CHECK(!deflater.hasFailed());
+    for (size_t position = 0; position < input.size(); position += writeLength) {
+        size_t count = input.size() - position < writeLength ? input.size() - position : writeLength;
+        deflater.write((const uint8_t*)input.data() + position, count);
+    }
+    deflater.finish();
+    return out.text;
+}
+
+static void testDeflateRoundTrip() {
+    std::string repeated;
+    for (int i = 0; i < 40; ++i) repeated += codecText();
+
+    std::string inputs[] = {
+        std::string(),
+        std::string("a"),
+        std::string("abcabcabcabcabc"),
+        codecText(),
+        repeated,
+        codecLongDistanceText(),
+        std::string(70000, 'x'),
+        noise(5000),
+    };
+    size_t writeLengths[] = {1, 7, 1000, 100000};
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+        for (size_t w = 0; w < sizeof(writeLengths) / sizeof(writeLengths[0]); ++w) {
+            std::string compressed = deflate(inputs[i], writeLengths[w]);
+            InflateResult result = inflateAll(EncodingGzip, (const uint8_t*)compressed.data(), compressed.size());
+            CHECK(result.done && !result.failed);
+            CHECK(result.output == inputs[i]);
+        }
+    }
+
+    // repetitive text has to shrink
+    CHECK(deflate(repeated, 1000).size() < repeated.size() / 4);
+}
+
+static std::string generatorInput;
+static size_t generatorPosition;
+
+static size_t generateBody(uint8_t* buffer, size_t size) {
+    size_t count = generatorInput.size() - generatorPosition;
+    if (count > size) count = size;
+    memcpy(buffer, generatorInput.data() + generatorPosition, count);
+    generatorPosition += count;
+    return count;
+}
+
+// Takes a chunked body apart, checking the framing of every chunk
+static bool dechunk(const std::string& text, std::string& body, size_t& chunks, size_t& largestChunk) {
+    body.clear();
+    chunks = 0;
+    largestChunk = 0;
+    size_t position = 0;
+    while (true) {
+        size_t lineEnd = text.find("\r\n", position);
+        if (lineEnd == std::string::npos || lineEnd == position) return false;
+        size_t length = strtoul(text.substr(position, lineEnd - position).c_str(), nullptr, 16);
+        position = lineEnd + 2;
+        if (length == 0) return text.compare(position, std::string::npos, "\r\n") == 0;
+
+        if (position + length + 2 > text.size() || text.compare(position + length, 2, "\r\n") != 0) return false;
+        body.append(text, position, length);
+        position += length + 2;
+        ++chunks;
+        if (length > largestChunk) largestChunk = length;
+    }
+}
+
+static void testCompressedChunks() {
+    // a compressed body of over 128 KB, written through buffers smaller and larger than a chunk can be
+    generatorInput = noise(120000);
+    size_t capacities[] = {64, 1460, 0xFFFF + 6, 70000, 200000};
+
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); ++c) {
+        std::vector<char> buffer(capacities[c]);
+        StringPrint out;
+        HttpRequestWriter writer(out, buffer.data(), buffer.size());
+        generatorPosition = 0;
+        writer.writeCompressedBody(HttpRequestBody::fromGenerator(&generateBody));
+        CHECK(writer.flush());
+
+        std::string body;
+        size_t chunks, largestChunk;
+        CHECK(dechunk(out.text, body, chunks, largestChunk));
+        CHECK(body.size() > 0xFFFF && largestChunk <= 0xFFFF);
+        if (capacities[c] > 0xFFFF + 8) CHECK(chunks >= 2 && largestChunk == 0xFFFF);
+
+        InflateResult result = inflateAll(EncodingGzip, (const uint8_t*)body.data(), body.size());
+        CHECK(result.done && !result.failed);
+        CHECK(result.output == generatorInput);
+    }
+}
+
+int main() {
+    testWholeStreams();
+    testSplitAtEveryPosition();
+    testCorruptStreams();
+    testParser();
+    testDeflateRoundTrip();
+    testCompressedChunks();
+
+    printf("%d checks, %d failed (inflate window: %d bits)\n", checks, failures, HTTP_INFLATE_WINDOW_BITS);
+    return failures == 0 ? 0 : 1;
+}
@@ -12,22 +12,74 @@
 #pragma once
 
 #include "LinkedList.h"
+#include "RingBuffer.h"
+#include "HttpPooledClient.h"
+#include "HttpRequestWriter.h"
+#include "HttpHeaders.h"
+#include "HttpResponseCache.h"
 #include "HttpRequest.h"
 #include "HttpResponse.h"
 #include "HttpCallback.h"
 #include "UrlParsing.h"
+#include "HttpEndpoint.h"
 #include "HttpResponseParsing.h"
+#include "HttpMetrics.h"
+#include "HttpDnsCache.h"
+#include "HttpBodyStream.h"
 
+// Default size of the buffer received bytes are read into before they are handed to the response parser
+#ifndef HTTP_RESPONSE_BUFFER_SIZE
 #define HTTP_RESPONSE_BUFFER_SIZE 1024
+#endif
+
+// Number of bytes loop() reads per request and call, bounds the time a single call takes
+#ifndef HTTP_LOOP_READ_BUDGET
+#define HTTP_LOOP_READ_BUDGET 1024
+#endif
+
+// Size of the transmit buffer requests are serialized into before they are written to the client
+#ifndef HTTP_REQUEST_BUFFER_SIZE
+#define HTTP_REQUEST_BUFFER_SIZE 256
+#endif
 #define RESPONSE_TIMEOUT_MS 60000
+#define KEEP_ALIVE_TIMEOUT_MS 5000
+
+// Longest a single connection attempt may block loop() on backends that support connect timeouts
+#ifndef CONNECT_TIMEOUT_MS
+#define CONNECT_TIMEOUT_MS 5000
+#endif
 
 // Max client instances for socket-limited boards like WiFiNINA, W5100
+#ifndef DEFAULT_MAX_CLIENTS
 #define DEFAULT_MAX_CLIENTS 4
+#endif
+
+// Max pending requests. Only requests pipelined on a shared connection can exceed the number of clients.
+#ifndef DEFAULT_MAX_REQUESTS
+#define DEFAULT_MAX_REQUESTS DEFAULT_MAX_CLIENTS
+#endif
+
+// Secure clients for https URLs of backends that support TLS, in addition to DEFAULT_MAX_CLIENTS.
+// Backends whose module only has DEFAULT_MAX_CLIENTS sockets (WiFiNINA, WiFi101) default to 0.
+#ifndef DEFAULT_MAX_SECURE_CLIENTS
+#define DEFAULT_MAX_SECURE_CLIENTS 1
+#endif
 
 /**
  * Base class for all specific HTTP request implementers.
+ *
+ * MaxClients is the number of clients (sockets) and MaxRequests the number of requests that can be
+ * pending at the same time. Clients, requests and their receive buffer are members of this class,
+ * so a global instance lives entirely in static memory and sending a request never allocates.
+ * Requests beyond the number of clients can only be pending while they are pipelined on a shared connection.
+ * ResponseBufferSize is the most that is read from a client at once.
+ *
+ * https URLs are sent with one of MaxSecureClients clients of type TSecureClient, which has to derive
+ * from TClient. They have their own pool, so plain requests never close an open TLS connection.
+ * Without secure clients https URLs fail with Failed_InvalidUrl.
  */
-template <typename TClient>
+template <typename TClient, size_t MaxClients = DEFAULT_MAX_CLIENTS, size_t MaxRequests = DEFAULT_MAX_REQUESTS, size_t ResponseBufferSize = HTTP_RESPONSE_BUFFER_SIZE,
+          typename TSecureClient = TClient, size_t MaxSecureClients = 0>
 class Http {
 public:
 
@@ -46,15 +98,102 @@ public:
         return requestTimeoutMs;
     }
 
+    /**
+     * @brief Enables or disables persistent (keep-alive) connections.
+     *
+     * When enabled, connections are kept open after a response and reused by the next request
+     * to the same host and port. Disabled by default.
+     */
+    void setKeepAlive(bool enabled) {
+        keepAlive = enabled;
+    }
+
+    /**
+     * @brief Whether persistent (keep-alive) connections are enabled.
+     */
+    bool getKeepAlive() {
+        return keepAlive;
+    }
+
+    /**
+     * @brief Sets how long an idle keep-alive connection is held open before it gets closed.
+     */
+    void setKeepAliveTimeoutMs(unsigned long timeoutMs) {
+        keepAliveTimeoutMs = timeoutMs;
+    }
+
+    /**
+     * @brief Gets the configured keep-alive idle timeout.
+     */
+    unsigned long getKeepAliveTimeoutMs() {
+        return keepAliveTimeoutMs;
+    }
+
+    /**
+     * @brief Sets how long a single connection attempt may take before it is given up.
+     *
+     * Connections are established from loop(), so this bounds how long one loop() call can block
+     * while a server does not answer. Backends whose client has no connect timeout ignore it.
+     */
+    void setConnectTimeoutMs(unsigned long timeoutMs) {
+        connectTimeoutMs = timeoutMs;
+    }
+
+    /**
+     * @brief Gets the configured connection timeout.
+     */
+    unsigned long getConnectTimeoutMs() {
+        return connectTimeoutMs;
+    }
+
+    /**
+     * @brief Sets how long the address a host name resolved to is used for new connections (0 disables the DNS cache).
+     *
+     * The Arduino DNS clients do not report the TTL of a record, so the same time applies to all hosts.
+     * A cached address is dropped as soon as connecting to it fails.
+     */
+    void setDnsCacheTtlMs(unsigned long ttlMs) {
+        dnsCache.setTtlMs(ttlMs);
+    }
+
+    /**
+     * @brief Gets the configured DNS cache TTL.
+     */
+    unsigned long getDnsCacheTtlMs() {
+        return dnsCache.getTtlMs();
+    }
+
+    /**
+     * @brief Sets how long requests to a host that could not be resolved fail right away instead of looking it up again (0 disables negative caching).
+     */
+    void setDnsNegativeCacheTtlMs(unsigned long ttlMs) {
+        dnsCache.setNegativeTtlMs(ttlMs);
+    }
+
+    /**
+     * @brief Gets the configured negative DNS cache TTL.
+     */
+    unsigned long getDnsNegativeCacheTtlMs() {
+        return dnsCache.getNegativeTtlMs();
+    }
+
+    /**
+     * @brief Forgets all cached host names, e.g. after the network has changed.
+     */
+    void clearDnsCache() {
+        dnsCache.clear();
+    }
+
     /**
      * @brief Sends an HTTP GET request to the specified URL.
      *
      * @param url The URL to request.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus get(const char* url, RequestCompletedCallback* onRequestCompleted) {
-        return get(String(url), onRequestCompleted);
+    HttpRequstStatus get(const char* url, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "GET", nullptr, nullptr, options);
     }
 
     /**
@@ -62,10 +201,45 @@ public:
      *
      * @param url The URL to request.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus get(const String& url, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return get(url.c_str(), onRequestCompleted, options);
+    }
+
+    /**
+     * @brief Sends an HTTP GET request and streams the response body instead of buffering it.
+     *
+     * Use this for payloads larger than the available RAM. The body is handed to onBodyChunk as it
+     * arrives and HttpResponse::contentText stays empty.
+     *
+     * @param url The URL to request.
+     * @param onHeaders Callback function invoked once the status line and headers are received (may be nullptr).
+     * @param onBodyChunk Callback function invoked for each received slice of the body.
+     * @param onRequestCompleted Callback function invoked when the response is complete.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus get(const char* url, ResponseHeadersCallback* onHeaders, ResponseBodyChunkCallback* onBodyChunk, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "GET", nullptr, nullptr, options, onHeaders, onBodyChunk);
+    }
+
+    /**
+     * @brief Sends an HTTP GET request and streams the response body instead of buffering it.
+     *
+     * Use this for payloads larger than the available RAM. The body is handed to onBodyChunk as it
+     * arrives and HttpResponse::contentText stays empty.
+     *
+     * @param url The URL to request.
+     * @param onHeaders Callback function invoked once the status line and headers are received (may be nullptr).
+     * @param onBodyChunk Callback function invoked for each received slice of the body.
+     * @param onRequestCompleted Callback function invoked when the response is complete.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus get(const String& url, RequestCompletedCallback* onRequestCompleted) {
-        return sendRequest(url, onRequestCompleted, "GET");
+    HttpRequstStatus get(const String& url, ResponseHeadersCallback* onHeaders, ResponseBodyChunkCallback* onBodyChunk, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return get(url.c_str(), onHeaders, onBodyChunk, onRequestCompleted, options);
     }
 
     /**
@@ -74,10 +248,11 @@ public:
      * @param url The URL to which data will be posted.
      * @param body The body of the POST request as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus post(const char* url, const char* body, RequestCompletedCallback* onRequestCompleted) {
-        return post(String(url), String(body), onRequestCompleted);
+    HttpRequstStatus post(const char* url, const char* body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return post(url, String(body), onRequestCompleted, options);
     }
 
     /**
@@ -86,36 +261,65 @@ public:
      * @param url The URL to which data will be posted.
      * @param body The body of the POST request as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus post(const char* url, const String& body, RequestCompletedCallback* onRequestCompleted) {
-        return post(String(url), body, onRequestCompleted);
+    HttpRequstStatus post(const char* url, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "POST", "application/json", &body, options);
     }
 
     /**
      * @brief Sends an HTTP POST request with a JSON body to the specified URL.
      *
      * @param url The URL to which data will be posted.
-     * @param body The body of the POST request as a JSON document.
+     * @param body The body of the POST request as a JSON document. If the request cannot be written right away, it is serialized into a copy.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus post(const char* url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted) {
-        return post(String(url), body, onRequestCompleted);
+    HttpRequstStatus post(const char* url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        HttpRequestBody source = HttpRequestBody::fromJson(body);
+        source.copyWhenKept = true;
+        return sendRequest(url, onRequestCompleted, "POST", source.contentType, nullptr, options, nullptr, nullptr, &source);
     }
 
     /**
      * @brief Sends an HTTP POST request with a JSON body to the specified URL.
      *
      * @param url The URL to which data will be posted.
-     * @param body The body of the POST request as a JSON document.
+     * @param body The body of the POST request as a JSON document. If the request cannot be written right away, it is serialized into a copy.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(const String& url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return post(url.c_str(), body, onRequestCompleted, options);
+    }
+
+    /**
+     * @brief Sends an HTTP POST request to the specified URL with a body read from a stream or generator.
+     *
+     * @param url The URL to which data will be posted.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(const char* url, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "POST", body.contentType, nullptr, options, nullptr, nullptr, &body);
+    }
+
+    /**
+     * @brief Sends an HTTP POST request to the specified URL with a body read from a stream or generator.
+     *
+     * @param url The URL to which data will be posted.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus post(const String& url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted) {
-        String serializedBody;
-        serializeJson(body, serializedBody);
-        return post(url, serializedBody, onRequestCompleted);
+    HttpRequstStatus post(const String& url, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return post(url.c_str(), body, onRequestCompleted, options);
     }
 
     /**
@@ -124,42 +328,65 @@ public:
      * @param url The URL to which data will be posted.
      * @param body The body of the POST request as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus post(const String& url, const String& body, RequestCompletedCallback* onRequestCompleted) {
-        String commands[] = { 
-            String("Content-Type: application/json"),
-            String("Content-Length: ") + String(body.length()),
-            String(),
-            body
-        };
-        return sendRequest(url, onRequestCompleted, "POST", commands, 4);
+    HttpRequstStatus post(const String& url, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return post(url.c_str(), body, onRequestCompleted, options);
     }
 
     /**
      * @brief Sends an HTTP PUT request with a JSON body to the specified URL.
      *
      * @param url The URL to which data will be put.
-     * @param body The body of the PUT request, as a JSON document.
+     * @param body The body of the PUT request, as a JSON document. If the request cannot be written right away, it is serialized into a copy.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus put(const char* url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted) {
-        return put(String(url), body, onRequestCompleted);
+    HttpRequstStatus put(const char* url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        HttpRequestBody source = HttpRequestBody::fromJson(body);
+        source.copyWhenKept = true;
+        return sendRequest(url, onRequestCompleted, "PUT", source.contentType, nullptr, options, nullptr, nullptr, &source);
     }
 
     /**
      * @brief Sends an HTTP PUT request with a JSON body to the specified URL.
      *
      * @param url The URL to which data will be put.
-     * @param body The body of the PUT request, as a JSON document.
+     * @param body The body of the PUT request, as a JSON document. If the request cannot be written right away, it is serialized into a copy.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(const String& url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return put(url.c_str(), body, onRequestCompleted, options);
+    }
+
+    /**
+     * @brief Sends an HTTP PUT request to the specified URL with a body read from a stream or generator.
+     *
+     * @param url The URL to which data will be put.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(const char* url, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "PUT", body.contentType, nullptr, options, nullptr, nullptr, &body);
+    }
+
+    /**
+     * @brief Sends an HTTP PUT request to the specified URL with a body read from a stream or generator.
+     *
+     * @param url The URL to which data will be put.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus put(const String& url, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted) {
-        String serializedBody;
-        serializeJson(body, serializedBody);
-        return put(url, serializedBody, onRequestCompleted);
+    HttpRequstStatus put(const String& url, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return put(url.c_str(), body, onRequestCompleted, options);
     }
 
     /**
@@ -168,10 +395,11 @@ public:
      * @param url The URL to which data will be put.
      * @param body The body of the PUT request, as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus put(const char* url, const char* body, RequestCompletedCallback* onRequestCompleted) {
-        return put(String(url), String(body), onRequestCompleted);
+    HttpRequstStatus put(const char* url, const char* body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return put(url, String(body), onRequestCompleted, options);
     }
 
     /**
@@ -180,10 +408,11 @@ public:
      * @param url The URL to which data will be put.
      * @param body The body of the PUT request, as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus put(const char* url, const String& body, RequestCompletedCallback* onRequestCompleted) {
-        return put(String(url), body, onRequestCompleted);
+    HttpRequstStatus put(const char* url, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "PUT", "application/json", &body, options);
     }
 
     /**
@@ -192,16 +421,11 @@ public:
      * @param url The URL to which data will be put.
      * @param body The body of the PUT request, as a JSON string.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus put(const String& url, const String& body, RequestCompletedCallback* onRequestCompleted) {
-        String commands[] = { 
-            String("Content-Type: application/json"),
-            String("Content-Length: ") + String(body.length()),
-            String(),
-            body
-        };
-        return sendRequest(url, onRequestCompleted, "PUT", commands, 4);
+    HttpRequstStatus put(const String& url, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return put(url.c_str(), body, onRequestCompleted, options);
     }
 
     /**
@@ -209,10 +433,11 @@ public:
      *
      * @param url The URL from which a resource will be deleted.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus del(const char* url, RequestCompletedCallback* onRequestCompleted) {
-        return del(String(url), onRequestCompleted);
+    HttpRequstStatus del(const char* url, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(url, onRequestCompleted, "DELETE", nullptr, nullptr, options);
     }
 
     /**
@@ -220,10 +445,11 @@ public:
      *
      * @param url The URL from which a resource will be deleted.
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus del(const String& url, RequestCompletedCallback* onRequestCompleted) {
-        return sendRequest(url, onRequestCompleted, "DELETE");
+    HttpRequstStatus del(const String& url, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return del(url.c_str(), onRequestCompleted, options);
     }
 
     /**
@@ -232,10 +458,12 @@ public:
      * @param url The URL to which data will be posted.
      * @param formString The form string to be posted (e.g. username=test&password=mypass1234)
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus postAsForm(const char* url, const char* formString, RequestCompletedCallback* onRequestCompleted) {
-        return postAsForm(String(url), formString, onRequestCompleted);
+    HttpRequstStatus postAsForm(const char* url, const char* formString, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        String formData = String(formString);
+        return sendRequest(url, onRequestCompleted, "POST", "application/x-www-form-urlencoded", &formData, options);
     }
 
     /**
@@ -244,192 +472,1401 @@ public:
      * @param url The URL to which data will be posted.
      * @param formString The form string to be posted (e.g. username=test&password=mypass1234)
      * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
      * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    HttpRequstStatus postAsForm(const String& url, const char* formString, RequestCompletedCallback* onRequestCompleted) {
-        String formData = String(formString);
-        String commands[] = { 
-            String("Content-Type: application/x-www-form-urlencoded"),
-            String("Content-Length: ") + String(formData.length()),
-            String(),
-            formData
-        };
-        return sendRequest(url, onRequestCompleted, "POST", commands, 4);
+    HttpRequstStatus postAsForm(const String& url, const char* formString, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return postAsForm(url.c_str(), formString, onRequestCompleted, options);
     }
 
-    virtual String getLocalIP() = 0;  // Pure virtual function - must be implemented by derived classes
-
     /**
-     * Call this method within your sketche's loop() function to process all the pending requests.
+     * @brief Sends an HTTP GET request to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to request.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
      */
-    void loop() {
-        size_t requestCount = pendingRequests->getSize();
+    HttpRequstStatus get(HttpEndpoint& endpoint, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "GET", nullptr, nullptr, options);
+    }
 
-        if (requestCount == 0) return;
+    /**
+     * @brief Sends an HTTP POST request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be posted.
+     * @param body The body of the POST request as a JSON string.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(HttpEndpoint& endpoint, const char* body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return post(endpoint, String(body), onRequestCompleted, options);
+    }
 
-        unsigned long ts = millis();
+    /**
+     * @brief Sends an HTTP POST request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be posted.
+     * @param body The body of the POST request as a JSON string.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(HttpEndpoint& endpoint, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "POST", "application/json", &body, options);
+    }
 
-        for (size_t i = 0; i < requestCount; ++i) {
-            HttpRequest<TClient>* request = nullptr;
-            if (!pendingRequests->get(i, request) || request == nullptr || !request->client->available()) {
-                // check if response timed out
-                unsigned long requestDurationMs = ts - request->requestStartTS;
-                if (requestDurationMs > requestTimeoutMs) {
-                    releaseClient(request->client);
-                    request->client = nullptr;
-
-                    if (request->callback != nullptr) {
-                        HttpResponse timeoutResponse;
-                        timeoutResponse.status = HttpRequstStatus::NoResponse;
-                        timeoutResponse.responseCode = 0;
-                        request->callback(timeoutResponse);
-                    }
-
-                    // Remove and delete the timed out request
-                    pendingRequests->removeAt(i);
-                    delete request;
-                    
-                    // Don't increment i since the next item is now at the same index
-                    --i;
-                    --requestCount;  // Update the count since we removed an item
-                }
-                continue;
-            }
+    /**
+     * @brief Sends an HTTP POST request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be posted.
+     * @param body The body of the POST request as a JSON document. If the request cannot be written right away, it is serialized into a copy.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(HttpEndpoint& endpoint, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        HttpRequestBody source = HttpRequestBody::fromJson(body);
+        source.copyWhenKept = true;
+        return sendRequest(endpoint, onRequestCompleted, "POST", source.contentType, nullptr, options, &source);
+    }
 
-            // Reset state for this request
-            size_t bytesRead = 0;
-            String responseText = String();
-            char localRespBuffer[HTTP_RESPONSE_BUFFER_SIZE];
-            char currentChar;
+    /**
+     * @brief Sends an HTTP POST request to a pre-parsed endpoint with a body read from a stream or generator.
+     *
+     * @param endpoint The endpoint to which data will be posted.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus post(HttpEndpoint& endpoint, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "POST", body.contentType, nullptr, options, &body);
+    }
 
-            // Process this request
-            while (request->client->available()) {
-                currentChar = request->client->read();
-                localRespBuffer[bytesRead++] = currentChar;
+    /**
+     * @brief Sends an HTTP PUT request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be put.
+     * @param body The body of the PUT request as a JSON string.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(HttpEndpoint& endpoint, const char* body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return put(endpoint, String(body), onRequestCompleted, options);
+    }
 
-                if (bytesRead == HTTP_RESPONSE_BUFFER_SIZE) {
-                    responseText.concat(localRespBuffer);
-                    bytesRead = 0;
-                }
-            }
-            
-            // Add remaining bytes
-            if (bytesRead > 0) {
-                responseText += String(localRespBuffer, bytesRead);
-            }
-            
-            // Serial.println(responseText);
-            HttpResponse response = HttpResponseParsing::parseResponse(responseText);
-            response.status = HttpRequstStatus::Completed;
-            releaseClient(request->client);
-            request->client = nullptr;
+    /**
+     * @brief Sends an HTTP PUT request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be put.
+     * @param body The body of the PUT request as a JSON string.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(HttpEndpoint& endpoint, const String& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "PUT", "application/json", &body, options);
+    }
 
-            if (request->callback != nullptr) {
-                request->callback(response);
-            }
+    /**
+     * @brief Sends an HTTP PUT request with a JSON body to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint to which data will be put.
+     * @param body The body of the PUT request as a JSON document. If the request cannot be written right away, it is serialized into a copy.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(HttpEndpoint& endpoint, const JsonDocument& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        HttpRequestBody source = HttpRequestBody::fromJson(body);
+        source.copyWhenKept = true;
+        return sendRequest(endpoint, onRequestCompleted, "PUT", source.contentType, nullptr, options, &source);
+    }
 
-            // Remove and delete the completed request
-            pendingRequests->removeAt(i);
-            delete request;
-            
-            // Don't increment i since the next item is now at the same index
-            --i;
-            --requestCount;  // Update the count since we removed an item
-        }
+    /**
+     * @brief Sends an HTTP PUT request to a pre-parsed endpoint with a body read from a stream or generator.
+     *
+     * @param endpoint The endpoint to which data will be put.
+     * @param body The source of the body, see HttpRequestBody. It has to stay usable until the completion callback was invoked.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus put(HttpEndpoint& endpoint, const HttpRequestBody& body, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "PUT", body.contentType, nullptr, options, &body);
     }
 
-    Http<TClient>(int maxClients = DEFAULT_MAX_CLIENTS) {
-        pendingRequests = new List<HttpRequest<TClient>*>();
-        clientPool = new List<TClient*>();
-        requestTimeoutMs = RESPONSE_TIMEOUT_MS;
-        this->maxClients = maxClients;
+    /**
+     * @brief Sends an HTTP DELETE request to a pre-parsed endpoint.
+     *
+     * @param endpoint The endpoint from which a resource will be deleted.
+     * @param onRequestCompleted Callback function invoked when the response is received.
+     * @param options Optional request settings (e.g. the priority when the request has to be queued).
+     * @return HttpRequstStatus Status indicating the current status of the request.
+     */
+    HttpRequstStatus del(HttpEndpoint& endpoint, RequestCompletedCallback* onRequestCompleted, const HttpRequestOptions& options = HttpRequestOptions()) {
+        return sendRequest(endpoint, onRequestCompleted, "DELETE", nullptr, nullptr, options);
+    }
 
-        for (int i = 0; i < maxClients; ++i) {
-            clientPool->add(new TClient());
-        }        
+    /**
+     * @brief Gets the ID of the request last passed to get(), post(), put() or del().
+     *
+     * The ID is reported to the callback in HttpResponse::requestId. IDs count up from 1 and wrap around.
+     *
+     * @return The ID, or 0 if the request failed right away (neither Sent nor Queued).
+     */
+    uint32_t getLastRequestId() const {
+        return lastRequestId;
     }
-    
-    ~Http<TClient>() {
-        // cleanup all pending requests
-        HttpRequest<TClient>* request;
-        while (pendingRequests->getSize() > 0) {
-            if (pendingRequests->get(0, request)) {
-                releaseClient(request->client);
-                delete request;
-                pendingRequests->removeAt(0);
+
+    /**
+     * @brief Cancels a pending or queued request. Its callback is not invoked.
+     *
+     * The connection of the request is closed and its client returns to the pool right away. If other
+     * requests are pipelined on the same connection, it is kept for them and the response is dropped.
+     *
+     * @param requestId The ID of the request, see getLastRequestId().
+     * @return true if the request was pending or queued.
+     */
+    bool cancel(uint32_t requestId) {
+        if (requestId == 0) return false;
+
+        for (size_t i = 0; i < maxQueuedRequests; ++i) {
+            HttpQueuedRequest& queued = queueSlots[i];
+            if (queued.used && queued.requestId == requestId) {
+                queued.callback = nullptr;
+                completeQueuedRequest(queued, HttpRequstStatus::NoResponse);
+                return true;
             }
         }
 
-        // cleanup client pool
-        for (size_t i = 0; i < clientPool->getSize(); ++i) {
-            TClient* client;
-            if (clientPool->get(i, client) && client) delete client;
+        for (HttpRequest<TClient>* request = pendingRequests.first(); request != nullptr; request = request->listNext) {
+            if (request->requestId != requestId) continue;
+
+            // the request completes without being reported
+            request->requestId = 0;
+            request->callback = nullptr;
+            request->jsonDocument = nullptr;
+            request->parser.setStreamCallbacks(nullptr, nullptr);
+            // in pull mode the parser skips the body instead of collecting it
+            request->parser.setPullBody(true);
+
+            if (!request->waitingForPipeline && request->pipelineNext == nullptr) {
+                // loop() frees the slot, as if the connection had broken
+                releaseClient(request->client, request->host, request->port, request->tls, false);
+                request->client = nullptr;
+                request->state = RequestAwaitingResponse;
+                request->releasePayload();
+            }
+            return true;
         }
-        delete pendingRequests;
-        delete clientPool;
+        return false;
     }
-    
-private:
-    List<HttpRequest<TClient>*>* pendingRequests;
-    List<TClient*>* clientPool;
-    int maxClients;
-    int requestTimeoutMs;
 
-    TClient* acquireClient() {
-        if (clientPool->getSize() == 0) return nullptr;
-        TClient* client;
-        clientPool->get(0, client);
-        clientPool->removeAt(0);
-        return client;
+    virtual String getLocalIP() = 0;  // Pure virtual function - must be implemented by derived classes
+
+    /**
+     * @brief Resolves a host name to an IP address. Implemented by backends that support DNS lookups.
+     *
+     * @return true if the host could be resolved.
+     */
+    virtual bool resolveHost(const char* host, IPAddress& address) {
+        return false;
     }
 
-    void releaseClient(TClient* client) {
-        if (!client) return;
-        client->stop();
-        clientPool->add(client);
+    /**
+     * @brief Connects a client to an IP address. Backends override this to bound the time the connection attempt may take.
+     *
+     * @param timeoutMs The connection timeout, see setConnectTimeoutMs().
+     * @return true if the client is connected.
+     */
+    virtual bool connectClient(TClient* client, const IPAddress& address, uint16_t port, unsigned long timeoutMs) {
+        // some clients report failures as negative values
+        return client->connect(address, port) > 0;
     }
 
-    HttpRequstStatus sendRequest(const String& url, RequestCompletedCallback* onRequestCompleted, const char* method) {
-        return sendRequest(url, onRequestCompleted, method, nullptr, 0);
+    /**
+     * @brief Connects a client to a host name. Backends override this to bound the time the connection attempt may take.
+     *
+     * @param timeoutMs The connection timeout, see setConnectTimeoutMs().
+     * @return true if the client is connected.
+     */
+    virtual bool connectClient(TClient* client, const char* host, uint16_t port, unsigned long timeoutMs) {
+        return client->connect(host, port) > 0;
     }
 
-    HttpRequstStatus sendRequest(const String& url, RequestCompletedCallback* onRequestCompleted, const char* method, String clientCommands[], int16_t commandCount) {
-        ParsedUrl parsedUrl = UrlParsing::parseUrl(url);
-        if (parsedUrl.failed) {
-            return HttpRequstStatus::Failed_InvalidUrl;
-        }
+    /**
+     * @brief Connects a secure client to a host name and performs the TLS handshake. Backends override this to bound
+     * the time the connection attempt may take.
+     *
+     * Secure clients always connect by name, the host name is needed to verify the server certificate.
+     * @param timeoutMs The connection timeout, see setConnectTimeoutMs().
+     * @return true if the client is connected.
+     */
+    virtual bool connectSecureClient(TSecureClient* client, const char* host, uint16_t port, unsigned long timeoutMs) {
+        return client->connect(host, port) > 0;
+    }
 
-        TClient* client = acquireClient();
-        if (!client) {
-            return HttpRequstStatus::Failed_TooManyConcurrentRequests;
-        }
+    /**
+     * @brief Gets one of the clients https URLs are sent with, e.g. to configure its certificates.
+     *
+     * @param index The client, less than MaxSecureClients.
+     */
+    TSecureClient& getSecureClient(size_t index) {
+        return *secureClients.get(index);
+    }
 
-        // Create and add request to the list
-        HttpRequest<TClient>* request = new HttpRequest<TClient>();
-        request->requestStartTS = millis();
-        request->client = client;
-        request->callback = onRequestCompleted;
-        pendingRequests->add(request);
-        
-        if (!request->client->connect(parsedUrl.host.c_str(), parsedUrl.port)) {
-            releaseClient(client);
-            return HttpRequstStatus::Failed_UnableToConnectToServer;
-        }
+    /**
+     * Call this method within your sketche's loop() function to process all the pending requests.
+     * Each call reads at most HTTP_LOOP_READ_BUDGET bytes per request so a large or slow response
+     * never stalls the sketch. New connections are established here as well, one host lookup or
+     * connection attempt per call. A request completes once its response is fully received.
+     *
+     * The exception is a response deserialized into HttpRequestOptions::jsonDocument: its body is read
+     * in one go once it begins, which blocks this call for up to HTTP_JSON_STREAM_MAX_WAIT_MS (200 ms
+     * by default) while the rest of the body arrives. Use a body chunk callback to avoid this.
+     */
+    void loop() {
+        unsigned long ts = millis();
+        evictIdleClients(ts);
+
+        HttpRequest<TClient>* next;
+        bool connectionStepTaken = false;
+
+        for (HttpRequest<TClient>* request = pendingRequests.first(); request != nullptr; request = next) {
+            next = request->listNext;
+
+            // pipelined requests wait until the response of their predecessor has been read
+            if (request->waitingForPipeline) continue;
 
-        String command = String(method) + String(" ") + parsedUrl.path + String(" HTTP/1.1");
-        String hostPart = String("Host: ") + getLocalIP();
+            HttpResponse& response = request->parser.response;
+            HTTP_METRICS(bool timedOut = false);
+            if (request->state != RequestAwaitingResponse) {
+                // a slow lookup or handshake blocks loop() at most once per call
+                if (isWithinDeadlines(request, ts)) {
+                    if (connectionStepTaken) continue;
+                    connectionStepTaken = true;
+                    if (advanceConnection(request)) continue;
+                }
+
+                HTTP_METRICS(++metrics.connectFailures);
+                HTTP_METRICS(request->sentUS = micros());
+                response.status = HttpRequstStatus::Failed_UnableToConnectToServer;
+            }
+            else {
+                if (request->client == nullptr) {
+                    // the connection of a pipeline broke before this response was received
+                    if (!request->parser.isDone()) request->parser.reset();
+                }
+                else if (!receiveResponse(request)) {
+                    // check if response timed out
+                    if (isWithinDeadlines(request, ts)) continue;
+
+                    // a response that has started keeps what arrived so far
+                    if (request->parser.hasStatusLine()) request->timedOut = true;
+                    else request->parser.reset();
+                    HTTP_METRICS(timedOut = true);
+                }
+                // reading a JSON body stops on its own once a deadline passes
+                HTTP_METRICS(timedOut = timedOut || request->timedOut);
+
+                if (request->timedOut) response.status = HttpRequstStatus::Failed_TimedOut;
+                else if (!request->parser.hasStatusLine()) response.status = HttpRequstStatus::NoResponse;
+                else if (request->parser.isTruncated() || request->parser.isMalformed()) response.status = HttpRequstStatus::Failed_IncompleteResponse;
+                else if (response.decompressionFailed) response.status = HttpRequstStatus::Failed_UnableToDecompressBody;
+                else response.status = HttpRequstStatus::Completed;
+            }
 
-        request->client->println(command.c_str());
-        request->client->println(hostPart.c_str());
-        request->client->println("Connection: close");
+            handOverClient(request);
 
-        if (clientCommands != nullptr) {
-            for (int16_t i = 0; i < commandCount; ++i) {
-                request->client->println(clientCommands[i].c_str());
+            if (request->cacheable && response.status == HttpRequstStatus::Completed
+                && !responseCache.update(request->getCacheKey(), response, !request->parser.isDelimitedByClose()) && !request->retried) {
+                // the body the server confirmed is no longer stored, so it is asked for again without validators
+                HttpRequstStatus status = resendRequest(request);
+                if (status == HttpRequstStatus::Sent) continue;
+                response.status = status;
             }
+            HTTP_METRICS(recordCompletion(request, timedOut));
+
+            // a timed out response was reset, so the request is identified again
+            response.requestId = request->requestId;
+            response.userContext = request->userContext;
+            if (request->callback != nullptr) {
+                HTTP_METRICS(unsigned long callbackStartUS = micros());
+                request->callback(response);
+                HTTP_METRICS(metrics.callbackUs += micros() - callbackStartUS);
+            }
+
+            // Remove the finished request and return its slot
+            pendingRequests.remove(request);
+            releaseRequest(request);
         }
-        request->client->println();
-        return HttpRequstStatus::Sent;
+
+        dispatchQueuedRequests(millis());
+    }
+
+    /**
+     * @brief Sets how many requests may wait for a free client (0 disables queuing, default).
+     *
+     * When all clients are busy, requests are queued instead of failing with
+     * Failed_TooManyConcurrentRequests and are sent from loop() once a client becomes available.
+     */
+    void setMaxQueuedRequests(size_t maxQueuedRequests) {
+        if (maxQueuedRequests == this->maxQueuedRequests) return;
+
+        // move the currently queued requests into the new slots
+        HttpQueuedRequest* slots = maxQueuedRequests > 0 ? new HttpQueuedRequest[maxQueuedRequests] : nullptr;
+        size_t count = 0;
+        for (size_t i = 0; i < this->maxQueuedRequests; ++i) {
+            HttpQueuedRequest& queued = queueSlots[i];
+            if (!queued.used) continue;
+
+            if (count < maxQueuedRequests) {
+                slots[count++] = queued;
+            }
+            else {
+                completeQueuedRequest(queued, HttpRequstStatus::Failed_TooManyConcurrentRequests);
+            }
+        }
+
+        delete[] queueSlots;
+        queueSlots = slots;
+        queuedCount = count;
+        this->maxQueuedRequests = maxQueuedRequests;
+    }
+
+    /**
+     * @brief Gets the maximum number of queued requests.
+     */
+    size_t getMaxQueuedRequests() {
+        return maxQueuedRequests;
+    }
+
+    /**
+     * @brief Sets how many GET requests may be in flight on a single keep-alive connection (1 disables pipelining, default).
+     *
+     * Pipelining is only used when keep-alive is enabled and no other client is available.
+     */
+    void setMaxPipelinedRequests(uint8_t maxPipelinedRequests) {
+        this->maxPipelinedRequests = maxPipelinedRequests > 0 ? maxPipelinedRequests : 1;
+    }
+
+    /**
+     * @brief Gets the maximum number of requests in flight per connection.
+     */
+    uint8_t getMaxPipelinedRequests() {
+        return maxPipelinedRequests;
+    }
+
+    /**
+     * @brief Captures the value of a response header in addition to Content-Type, Content-Length and Server.
+     *
+     * The value is available through HttpResponse::getHeader(). The headers of all other names are skipped
+     * without being copied.
+     * @param name The header name (e.g. "ETag", "Location"), matched case-insensitively. It is not copied
+     *             and has to outlive this instance (e.g. a string literal).
+     * @return false if HTTP_MAX_RESPONSE_HEADERS headers are registered already
+     */
+    bool captureResponseHeader(const char* name) {
+        return responseHeaders.add(name);
+    }
+
+    /**
+     * @brief Sets how many GET responses are kept for revalidation (0 disables the cache, default).
+     *
+     * Responses that come with an ETag or Last-Modified header are stored with their body, unless they are marked
+     * Cache-Control no-store or private or their body ended with the connection instead of its length. The next
+     * GET request of the same URL is sent with If-None-Match / If-Modified-Since, and if the server
+     * answers 304 Not Modified, the callback receives the stored body with responseCode 200 and
+     * HttpResponse::fromCache set. Streamed requests and requests with a JSON document bypass the cache.
+     * @return false if the ETag, Last-Modified and Cache-Control headers could not be captured (see captureResponseHeader())
+     */
+    bool setResponseCacheSize(size_t entries) {
+        if (entries > 0 && (!responseHeaders.add("ETag") || !responseHeaders.add("Last-Modified") || !responseHeaders.add("Cache-Control"))) return false;
+        responseCache.setSize(entries);
+        return true;
+    }
+
+    size_t getResponseCacheSize() const {
+        return responseCache.getSize();
+    }
+
+    /**
+     * @brief Drops all cached responses.
+     */
+    void clearResponseCache() {
+        responseCache.clear();
+    }
+
+    /**
+     * @brief Sets headers sent with every request, e.g. Authorization or User-Agent.
+     *
+     * The headers are rendered once and copied into each request as a block, before the headers
+     * passed in HttpRequestOptions::headers.
+     * @param headers The headers or nullptr to send none. They are not copied and have to outlive this instance.
+     */
+    void setDefaultHeaders(const HttpHeaders* headers) {
+        defaultHeaders = headers;
+    }
+
+    const HttpHeaders* getDefaultHeaders() const {
+        return defaultHeaders;
+    }
+
+    /**
+     * @brief Asks servers for gzip or deflate compressed responses and inflates them as they arrive.
+     *
+     * Requests are sent with "Accept-Encoding: gzip, deflate". Compressed bodies are inflated before
+     * they reach contentText, the body chunk callback or the JSON document, without buffering the
+     * compressed body. While a compressed body is received, its request holds an inflate window of
+     * 2^HTTP_INFLATE_WINDOW_BITS bytes (4 KB by default, 32 KB on ESP32 and RP2040) and about 1.5 KB of
+     * decoder state. Servers compress with a 32 KB window, so with a smaller one only requests with
+     * HttpRequestOptions::acceptCompressed ask for compressed responses. A body that cannot be inflated
+     * completes the request with Failed_UnableToDecompressBody.
+     * contentLength stays the length of the body as transferred. Disabled by default.
+     */
+    void setDecompressResponses(bool enabled) {
+        decompressResponses = enabled;
+    }
+
+    bool getDecompressResponses() const {
+        return decompressResponses;
+    }
+
+#if HTTP_ENABLE_METRICS
+    /**
+     * @brief Gets the counters aggregated over all requests since the last reset.
+     *
+     * Only available when HTTP_ENABLE_METRICS is set to 1. The durations of the phases of each request
+     * are reported in HttpResponse::timings.
+     */
+    const HttpMetrics& getMetrics() const {
+        return metrics;
+    }
+
+    /**
+     * @brief Sets all counters back to 0.
+     */
+    void resetMetrics() {
+        metrics.reset();
+    }
+#endif
+
+    /**
+     * @param maxClients Number of clients to use, at most MaxClients.
+     */
+    Http(int maxClients = MaxClients) {
+        queueSlots = nullptr;
+        queuedCount = 0;
+        queueSequence = 0;
+        nextRequestId = 0;
+        defaultHeaders = nullptr;
+        lastRequestId = 0;
+        requestTimeoutMs = RESPONSE_TIMEOUT_MS;
+        keepAlive = false;
+        decompressResponses = false;
+        keepAliveTimeoutMs = KEEP_ALIVE_TIMEOUT_MS;
+        connectTimeoutMs = CONNECT_TIMEOUT_MS;
+        maxQueuedRequests = 0;
+        maxPipelinedRequests = 1;
+        this->maxClients = maxClients > 0 && (size_t)maxClients < MaxClients ? maxClients : MaxClients;
+
+        for (int i = 0; i < this->maxClients; ++i) {
+            HttpPooledClient<TClient> pooled;
+            pooled.client = &clients[i];
+            clientPool.add(pooled);
+        }
+
+        for (size_t i = 0; i < MaxSecureClients; ++i) {
+            HttpPooledClient<TClient> pooled;
+            pooled.client = secureClients.get(i);
+            pooled.secure = true;
+            clientPool.add(pooled);
+        }
+
+        for (size_t i = 0; i < MaxRequests; ++i) {
+            freeRequests.add(&requestSlots[i]);
+        }
+    }
+    
+    ~Http() {
+        // cleanup all pending requests
+        HttpRequest<TClient>* request;
+        while ((request = pendingRequests.first()) != nullptr) {
+            // pipelined requests share the client of the request ahead of them
+            if (!request->waitingForPipeline) {
+                releaseClient(request->client, request->host, request->port, request->tls, false);
+            }
+            pendingRequests.remove(request);
+        }
+
+        // cleanup client pool
+        for (size_t i = 0; i < clientPool.getSize(); ++i) {
+            HttpPooledClient<TClient>& pooled = clientPool[i];
+            if (pooled.client) {
+                pooled.client->stop();
+            }
+        }
+        delete[] queueSlots;
+    }
+    
+private:
+    TClient clients[MaxClients];
+    HttpClientArray<TSecureClient, MaxSecureClients> secureClients;
+    HttpRequest<TClient> requestSlots[MaxRequests];
+    LinkedList<HttpRequest<TClient>> pendingRequests;
+    LinkedList<HttpRequest<TClient>> freeRequests;
+    RingBuffer<HttpPooledClient<TClient>, MaxClients + MaxSecureClients> clientPool;
+    HttpQueuedRequest* queueSlots;
+    size_t queuedCount;
+    uint32_t queueSequence;
+    uint32_t nextRequestId;
+    uint32_t lastRequestId;
+    const HttpHeaders* defaultHeaders;
+    int maxClients;
+    int requestTimeoutMs;
+    bool keepAlive;
+    bool decompressResponses;
+    unsigned long keepAliveTimeoutMs;
+    unsigned long connectTimeoutMs;
+    size_t maxQueuedRequests;
+    uint8_t maxPipelinedRequests;
+    char requestBuffer[HTTP_REQUEST_BUFFER_SIZE];
+    uint8_t responseBuffer[ResponseBufferSize > 0 ? ResponseBufferSize : 1];
+    HttpHeaderTable responseHeaders;
+    HttpResponseCache responseCache;
+    HttpDnsCache dnsCache;
+#if HTTP_ENABLE_METRICS
+    HttpMetrics metrics;
+#endif
+
+    /**
+     * Takes a client from the pool, a secure one for https URLs. An idle connection to the same host
+     * and port is preferred, otherwise a client without an open connection is used.
+     * isConnected reports whether the returned client is already connected to the origin.
+     */
+    TClient* acquireClient(const UrlView& url, bool& isConnected) {
+        size_t poolSize = clientPool.getSize();
+        isConnected = false;
+
+        size_t index = 0;
+        bool found = false;
+        bool foundFree = false;
+
+        for (size_t i = 0; i < poolSize; ++i) {
+            HttpPooledClient<TClient>& pooled = clientPool[i];
+            if (pooled.secure != url.tls) continue;
+
+            if (pooled.isConnectedTo(url) && pooled.client->connected()) {
+                index = i;
+                isConnected = true;
+                found = true;
+                break;
+            }
+            if (!found || (!foundFree && !pooled.holdsConnection())) {
+                index = i;
+                found = true;
+                foundFree = !pooled.holdsConnection();
+            }
+        }
+        if (!found) return nullptr;
+
+        HttpPooledClient<TClient>& pooled = clientPool[index];
+        TClient* client = pooled.client;
+
+        if (!isConnected && pooled.holdsConnection()) {
+            // close the stale connection or the connection to another origin
+            client->stop();
+        }
+        clientPool.removeAt(index);
+        return client;
+    }
+
+    /**
+     * Closes all keep-alive connections that have been idle for longer than keepAliveTimeoutMs
+     * or have been closed by the server.
+     */
+    void evictIdleClients(unsigned long ts) {
+        size_t poolSize = clientPool.getSize();
+
+        for (size_t i = 0; i < poolSize; ++i) {
+            HttpPooledClient<TClient>& pooled = clientPool[i];
+            if (!pooled.holdsConnection()) continue;
+            if (ts - pooled.idleSinceTS <= keepAliveTimeoutMs && pooled.client->connected()) continue;
+
+            pooled.client->stop();
+            pooled.clearConnection();
+        }
+    }
+
+    /**
+     * Feeds the bytes currently available for the given request into its response parser.
+     * Returns true once the response is complete or the server closed the connection.
+     */
+    bool receiveResponse(HttpRequest<TClient>* request) {
+        HttpResponseParser& parser = request->parser;
+        TClient* client = request->client;
+        const char* buffer = (const char*)responseBuffer;
+        size_t budget = HTTP_LOOP_READ_BUDGET;
+
+        while (budget > 0 && !parser.isDone()) {
+            // read everything that is available at once: a single SPI transaction or socket read instead of one per byte
+            int available = client->available();
+            if (available <= 0) break;
+
+            size_t length = (size_t)available;
+            if (length > sizeof(responseBuffer)) length = sizeof(responseBuffer);
+            if (length > budget) length = budget;
+
+            int result = client->read(responseBuffer, length);
+            if (result <= 0) break;
+
+            size_t bytesRead = (size_t)result;
+            budget -= bytesRead;
+
+#if HTTP_ENABLE_METRICS
+            unsigned long readUS = micros();
+            if (!request->receivedFirstByte) {
+                request->firstByteUS = readUS;
+            }
+            request->lastByteUS = readUS;
+            metrics.bytesReceived += bytesRead;
+#endif
+            request->receivedFirstByte = true;
+
+            feedParser(request, buffer, bytesRead);
+            HTTP_METRICS(request->timings.parseUs += micros() - readUS);
+        }
+
+        if (parser.isDone() || request->timedOut) return true;
+
+        if (!client->connected() && !client->available()) {
+            parser.finish();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Passes received bytes to the parser of a request. A JSON body is deserialized as soon as it begins,
+     * bytes past the end of the response go to the requests pipelined behind it.
+     */
+    void feedParser(HttpRequest<TClient>* request, const char* data, size_t length) {
+        HttpResponseParser& parser = request->parser;
+
+        while ((length > 0 || parser.hasPendingBody()) && !parser.isDone()) {
+            // in pull mode the parser stops at the start of the body and after every slice of it
+            size_t consumed = parser.consume(data, length);
+            data += consumed;
+            length -= consumed;
+
+            if (request->jsonDocument != nullptr && parser.getState() == ParsingBody) {
+                deserializeBody(request, data, length);
+            }
+        }
+
+        if (length > 0) {
+            forwardToPipeline(request, data, length);
+        }
+    }
+
+    /**
+     * Deserializes the body of a successful response into the JSON document of the request, reading
+     * the rest of the body from the client. Responses with other status codes are collected into
+     * contentText. data and length are updated to the bytes that are left after the body.
+     */
+    void deserializeBody(HttpRequest<TClient>* request, const char*& data, size_t& length) {
+        HttpResponseParser& parser = request->parser;
+        HttpResponse& response = parser.response;
+        JsonDocument* document = request->jsonDocument;
+        request->jsonDocument = nullptr;
+
+        if (response.responseCode < 200 || response.responseCode >= 300) {
+            parser.setPullBody(false);
+            return;
+        }
+
+        // reading blocks loop(), so it ends with the deadlines of the request or after HTTP_JSON_STREAM_MAX_WAIT_MS
+        unsigned long maxWaitMs = getRemainingMs(request, millis());
+        if (maxWaitMs > HTTP_JSON_STREAM_MAX_WAIT_MS) maxWaitMs = HTTP_JSON_STREAM_MAX_WAIT_MS;
+
+        // whatever follows the JSON value (e.g. a trailing line break) is discarded by the parser in pull mode
+        HttpBodyStream<TClient> body(parser, *request->client, data, length, responseBuffer, sizeof(responseBuffer), request->requestId, maxWaitMs);
+        if (request->jsonFilter != nullptr) {
+            response.jsonError = deserializeJson(*document, body, DeserializationOption::Filter(*request->jsonFilter));
+        }
+        else {
+            response.jsonError = deserializeJson(*document, body);
+        }
+        HTTP_METRICS(metrics.bytesReceived += body.getBytesRead());
+        data = body.getPending(length);
+        if (body.hasTimedOut()) request->timedOut = true;
+    }
+
+    /**
+     * Hands bytes that were read past the end of a response to the requests pipelined behind it.
+     */
+    void forwardToPipeline(HttpRequest<TClient>* request, const char* data, size_t length) {
+        HttpRequest<TClient>* next = request->pipelineNext;
+        while (next != nullptr && length > 0) {
+            size_t consumed = next->parser.consume(data, length);
+            data += consumed;
+            length -= consumed;
+            next = next->pipelineNext;
+        }
+
+        // bytes nobody asked for leave the connection in an unknown state
+        if (length > 0) request->discardedBytes = true;
+    }
+
+    /**
+     * Checks the deadlines of a pending request: the connect deadline (or the request timeout) until it
+     * has been written, then the first byte deadline and the request timeout. A total deadline replaces
+     * the request timeout.
+     */
+    bool isWithinDeadlines(HttpRequest<TClient>* request, unsigned long ts) {
+        unsigned long elapsedMs = ts - request->requestStartTS;
+        if (request->state != RequestAwaitingResponse) {
+            if (elapsedMs > (request->connectTimeoutMs > 0 ? request->connectTimeoutMs : (unsigned long)requestTimeoutMs)) return false;
+        }
+        else if (request->firstByteTimeoutMs > 0 && !request->receivedFirstByte && elapsedMs > request->firstByteTimeoutMs) {
+            return false;
+        }
+
+        if (request->timeoutMs > 0) return ts - request->acceptedTS <= request->timeoutMs;
+        return request->state != RequestAwaitingResponse || elapsedMs <= (unsigned long)requestTimeoutMs;
+    }
+
+    /**
+     * Gets the time left until the request timeout (or total deadline) of a request that has been written.
+     */
+    unsigned long getRemainingMs(HttpRequest<TClient>* request, unsigned long ts) {
+        unsigned long elapsedMs = request->timeoutMs > 0 ? ts - request->acceptedTS : ts - request->requestStartTS;
+        unsigned long limitMs = request->timeoutMs > 0 ? request->timeoutMs : (unsigned long)requestTimeoutMs;
+        return elapsedMs < limitMs ? limitMs - elapsedMs : 0;
+    }
+
+    /**
+     * Passes the client of a finished request on to the next pipelined request or returns it to the pool.
+     */
+    void handOverClient(HttpRequest<TClient>* request) {
+        HttpRequest<TClient>* next = request->pipelineNext;
+        bool reusable = request->client != nullptr && request->parser.isConnectionReusable() && !request->discardedBytes;
+
+        if (next != nullptr && reusable) {
+            next->waitingForPipeline = false;
+        }
+        else {
+            releaseClient(request->client, request->host, request->port, request->tls, reusable);
+
+            // requests pipelined behind a broken connection will not receive a response
+            for (; next != nullptr; next = next->pipelineNext) {
+                next->client = nullptr;
+                next->waitingForPipeline = false;
+                next->state = RequestAwaitingResponse;
+            }
+        }
+
+        request->client = nullptr;
+        request->pipelineNext = nullptr;
+    }
+
+#if HTTP_ENABLE_METRICS
+    /**
+     * Completes the timings of a finished request, hands them to its response and updates the counters.
+     */
+    void recordCompletion(HttpRequest<TClient>* request, bool timedOut) {
+        HttpRequestTimings& timings = request->timings;
+        if (request->receivedFirstByte) {
+            timings.firstByteUs = request->firstByteUS - request->sentUS;
+            timings.transferUs = request->lastByteUS - request->firstByteUS;
+        }
+        timings.totalUs = timings.connectUs + timings.sendUs + (micros() - request->sentUS);
+        request->parser.response.timings = timings;
+
+        if (timedOut) {
+            ++metrics.timeouts;
+        }
+        else if (request->parser.response.status == HttpRequstStatus::Completed) {
+            ++metrics.completed;
+            metrics.recordLatency(timings.totalUs / 1000);
+        }
+    }
+#endif
+
+    /**
+     * Returns the slot of a finished request to the slab. The response strings are freed right away.
+     */
+    void releaseRequest(HttpRequest<TClient>* request) {
+        request->reset();
+        freeRequests.add(request);
+    }
+
+    /**
+     * Returns a client to the pool. If keepOpen is set and keep-alive is enabled, the connection
+     * stays open for the next request to the same host and port.
+     */
+    void releaseClient(TClient* client, const char* host, uint16_t port, bool secure, bool keepOpen) {
+        if (!client) return;
+
+        HttpPooledClient<TClient> pooled;
+        pooled.client = client;
+        pooled.secure = secure;
+
+        if (keepAlive && keepOpen && client->connected() && !client->available()) {
+            strcpy(pooled.host, host);
+            pooled.port = port;
+            pooled.idleSinceTS = millis();
+        }
+        else {
+            client->stop();
+        }
+        clientPool.add(pooled);
+    }
+
+    /**
+     * Finds the last request of a keep-alive connection to the given origin that another GET
+     * request can be pipelined behind. Returns nullptr if there is none.
+     */
+    HttpRequest<TClient>* findPipelineTail(const UrlView& url) {
+        if (!keepAlive || maxPipelinedRequests <= 1) return nullptr;
+
+        for (HttpRequest<TClient>* request = pendingRequests.first(); request != nullptr; request = request->listNext) {
+            if (request->client == nullptr || request->pipelineNext != nullptr || !request->idempotent) continue;
+            if (request->tls != url.tls || request->port != url.port || !url.isHost(request->host)) continue;
+
+            uint8_t depth = 0;
+            for (HttpRequest<TClient>* other = pendingRequests.first(); other != nullptr; other = other->listNext) {
+                if (other->client == request->client) ++depth;
+            }
+            if (depth < maxPipelinedRequests) return request;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Sends queued requests (highest priority first) as long as clients are available.
+     * Requests that waited longer than their timeout (or the request timeout) are completed with NoResponse.
+     */
+    void dispatchQueuedRequests(unsigned long ts) {
+        while (queuedCount > 0) {
+            HttpQueuedRequest* candidate = nullptr;
+
+            for (size_t i = 0; i < maxQueuedRequests; ++i) {
+                HttpQueuedRequest& queued = queueSlots[i];
+                if (!queued.used) continue;
+                if (candidate == nullptr || queued.options.priority > candidate->options.priority
+                    || (queued.options.priority == candidate->options.priority && (int32_t)(queued.sequence - candidate->sequence) < 0)) {
+                    candidate = &queued;
+                }
+            }
+
+            HttpRequstStatus status;
+            unsigned long waitedMs = ts - candidate->queuedTS;
+            if (candidate->options.timeoutMs > 0 ? waitedMs >= candidate->options.timeoutMs : waitedMs > (unsigned long)requestTimeoutMs) {
+                status = HttpRequstStatus::NoResponse;
+            }
+            else {
+                // the time spent in the queue counts towards the deadline of the request
+                HttpRequestOptions options = candidate->options;
+                if (options.timeoutMs > 0) options.timeoutMs -= waitedMs;
+
+                status = startRequest(candidate->endpoint != nullptr ? candidate->endpoint->getUrl() : UrlView(candidate->url.c_str()), candidate->endpoint, candidate->method, candidate->contentType, candidate->hasBody ? &candidate->body : nullptr,
+                                      candidate->hasBodySource ? &candidate->bodySource : nullptr, options, candidate->requestId, candidate->callback, candidate->onHeaders, candidate->onBodyChunk);
+                if (status == HttpRequstStatus::Failed_TooManyConcurrentRequests) return;
+            }
+
+            completeQueuedRequest(*candidate, status);
+        }
+    }
+
+    /**
+     * Frees the slot of a queued request and reports it to the callback unless it was sent.
+     */
+    void completeQueuedRequest(HttpQueuedRequest& queued, HttpRequstStatus status) {
+        RequestCompletedCallback* callback = queued.callback;
+
+        queued.used = false;
+        queued.url = String();
+        queued.body = String();
+        queued.hasBodySource = false;
+        --queuedCount;
+
+        if (status != HttpRequstStatus::Sent && callback != nullptr) {
+            HttpResponse failedResponse;
+            failedResponse.status = status;
+            failedResponse.responseCode = 0;
+            failedResponse.contentLength = 0;
+            failedResponse.requestId = queued.requestId;
+            failedResponse.userContext = queued.options.userContext;
+            callback(failedResponse);
+        }
+    }
+
+    HttpRequstStatus sendRequest(const char* url, RequestCompletedCallback* onRequestCompleted, const char* method, const char* contentType, const String* body,
+                                 const HttpRequestOptions& options, ResponseHeadersCallback* onHeaders = nullptr, ResponseBodyChunkCallback* onBodyChunk = nullptr,
+                                 const HttpRequestBody* bodySource = nullptr) {
+        if (body != nullptr && options.compressBody) {
+            return sendRequest(url, onRequestCompleted, method, contentType, body, uncompressed(options), onHeaders, onBodyChunk, bodySource);
+        }
+
+        lastRequestId = 0;
+        UrlView parsedUrl(url);
+        if (parsedUrl.failed || parsedUrl.hostLength() > HTTP_MAX_HOST_LENGTH || (parsedUrl.tls && MaxSecureClients == 0)) {
+            return HttpRequstStatus::Failed_InvalidUrl;
+        }
+
+        uint32_t requestId = takeRequestId();
+        HttpRequstStatus status = startRequest(parsedUrl, nullptr, method, contentType, body, bodySource, options, requestId, onRequestCompleted, onHeaders, onBodyChunk);
+        if (status == HttpRequstStatus::Failed_TooManyConcurrentRequests) {
+            HTTP_METRICS(++metrics.poolExhausted);
+            status = queueRequest(url, nullptr, method, contentType, body, bodySource, options, requestId, onRequestCompleted, onHeaders, onBodyChunk);
+        }
+        if (status == HttpRequstStatus::Sent || status == HttpRequstStatus::Queued) lastRequestId = requestId;
+        return status;
+    }
+
+    HttpRequstStatus sendRequest(HttpEndpoint& endpoint, RequestCompletedCallback* onRequestCompleted, const char* method, const char* contentType, const String* body,
+                                 const HttpRequestOptions& options, const HttpRequestBody* bodySource = nullptr) {
+        if (body != nullptr && options.compressBody) {
+            return sendRequest(endpoint, onRequestCompleted, method, contentType, body, uncompressed(options), bodySource);
+        }
+
+        lastRequestId = 0;
+        if (!endpoint.isValid() || (endpoint.getUrl().tls && MaxSecureClients == 0)) {
+            return HttpRequstStatus::Failed_InvalidUrl;
+        }
+
+        uint32_t requestId = takeRequestId();
+        HttpRequstStatus status = startRequest(endpoint.getUrl(), &endpoint, method, contentType, body, bodySource, options, requestId, onRequestCompleted, nullptr, nullptr);
+        if (status == HttpRequstStatus::Failed_TooManyConcurrentRequests) {
+            HTTP_METRICS(++metrics.poolExhausted);
+            status = queueRequest(nullptr, &endpoint, method, contentType, body, bodySource, options, requestId, onRequestCompleted, nullptr, nullptr);
+        }
+        if (status == HttpRequstStatus::Sent || status == HttpRequstStatus::Queued) lastRequestId = requestId;
+        return status;
+    }
+
+    // A body passed as a String is already held in memory and is sent as it is, see HttpRequestOptions::compressBody
+    static HttpRequestOptions uncompressed(const HttpRequestOptions& options) {
+        HttpRequestOptions result = options;
+        result.compressBody = false;
+        return result;
+    }
+
+    // IDs count up from 1, 0 marks a request that was not accepted
+    uint32_t takeRequestId() {
+        if (++nextRequestId == 0) ++nextRequestId;
+        return nextRequestId;
+    }
+
+    /**
+     * Keeps a copy of a request that could not be sent because all clients are busy.
+     * A JSON document passed to post() or put() is serialized right away, as it might not exist anymore
+     * when the request is sent. One passed with HttpRequestBody::fromJson() is kept as a pointer.
+     */
+    HttpRequstStatus queueRequest(const char* url, HttpEndpoint* endpoint, const char* method, const char* contentType, const String* body, const HttpRequestBody* bodySource,
+                                  const HttpRequestOptions& options, uint32_t requestId,
+                                  RequestCompletedCallback* onRequestCompleted, ResponseHeadersCallback* onHeaders, ResponseBodyChunkCallback* onBodyChunk) {
+        if (queuedCount >= maxQueuedRequests) {
+            return HttpRequstStatus::Failed_TooManyConcurrentRequests;
+        }
+
+        HttpQueuedRequest* queued = queueSlots;
+        while (queued->used) ++queued;
+
+        queued->used = true;
+        queued->sequence = queueSequence++;
+        queued->requestId = requestId;
+        if (url != nullptr) queued->url = url;
+        queued->endpoint = endpoint;
+        queued->method = method;
+        queued->contentType = contentType;
+        queued->hasBody = body != nullptr;
+        if (body != nullptr) {
+            queued->body = *body;
+        }
+        keepBodySource(bodySource, queued->body, queued->hasBody, queued->bodySource, queued->hasBodySource);
+        queued->callback = onRequestCompleted;
+        queued->onHeaders = onHeaders;
+        queued->onBodyChunk = onBodyChunk;
+        queued->options = options;
+        queued->queuedTS = millis();
+        ++queuedCount;
+        return HttpRequstStatus::Queued;
+    }
+
+    HttpRequstStatus startRequest(const UrlView& parsedUrl, HttpEndpoint* endpoint, const char* method, const char* contentType, const String* body, const HttpRequestBody* bodySource,
+                                  const HttpRequestOptions& options, uint32_t requestId,
+                                  RequestCompletedCallback* onRequestCompleted, ResponseHeadersCallback* onHeaders, ResponseBodyChunkCallback* onBodyChunk) {
+        bool idempotent = strcmp(method, "GET") == 0;
+        bool cacheable = idempotent && responseCache.getSize() > 0 && onBodyChunk == nullptr && options.jsonDocument == nullptr;
+        HttpRequest<TClient>* pipelineTail = nullptr;
+
+        // every pending request occupies a slot until its callback has been invoked
+        if (freeRequests.first() == nullptr) {
+            return HttpRequstStatus::Failed_TooManyConcurrentRequests;
+        }
+
+        char hostBuffer[HTTP_MAX_HOST_LENGTH + 1];
+        const char* host = hostBuffer;
+        if (endpoint != nullptr) {
+            host = endpoint->getHost();
+        }
+        else if (!parsedUrl.copyHost(hostBuffer, sizeof(hostBuffer))) {
+            return HttpRequstStatus::Failed_InvalidUrl;
+        }
+
+        HTTP_METRICS(unsigned long connectStartUS = micros());
+        bool isConnected;
+        TClient* client = acquireClient(parsedUrl, isConnected);
+        if (!client) {
+            // all clients are busy: try to pipeline the request on an open connection to the same origin
+            // a JSON body is read straight from the client, which only works for the request at the head of the connection
+            if (idempotent && options.jsonDocument == nullptr) pipelineTail = findPipelineTail(parsedUrl);
+            if (pipelineTail == nullptr) {
+                return HttpRequstStatus::Failed_TooManyConcurrentRequests;
+            }
+            client = pipelineTail->client;
+        }
+
+        if (pipelineTail != nullptr ? pipelineTail->state != RequestAwaitingResponse : !isConnected) {
+            // the connection is established from loop(), so the request is kept until it can be written
+            HttpRequest<TClient>* request = addRequest(client, host, parsedUrl.port, parsedUrl.tls, idempotent, options, requestId, onRequestCompleted, onHeaders, onBodyChunk);
+            keepUrl(request, parsedUrl, endpoint, cacheable);
+            request->method = method;
+            request->contentType = contentType;
+            if (body != nullptr) request->keepBody(*body);
+            keepBodySource(bodySource, request->body, request->hasBody, request->bodySource, request->hasBodySource);
+
+            if (pipelineTail != nullptr) {
+                // written right after the request ahead of it
+                pipelineTail->pipelineNext = request;
+                request->waitingForPipeline = true;
+                request->state = RequestConnecting;
+            }
+            else if (parsedUrl.tls) {
+                // secure clients connect by name
+                request->state = RequestConnecting;
+            }
+            else if (endpoint != nullptr && endpoint->isResolved(millis(), dnsCache.getTtlMs())) {
+                request->address = endpoint->getAddress();
+                request->hasAddress = true;
+                request->state = RequestConnecting;
+            }
+            else if (dnsCache.lookup(host, millis(), request->address) == DnsCacheHit) {
+                request->hasAddress = true;
+                request->state = RequestConnecting;
+            }
+            else {
+                request->state = RequestResolving;
+            }
+            return HttpRequstStatus::Sent;
+        }
+
+        HTTP_METRICS(unsigned long sendStartUS = micros());
+        if (!writeRequest(client, parsedUrl, endpoint, method, contentType, options.headers, cacheable, options.compressBody, options.acceptCompressed,
+                          body != nullptr ? body->c_str() : nullptr, body != nullptr ? body->length() : 0, bodySource)) {
+            HTTP_METRICS(++metrics.connectFailures);
+            // a pipelined connection is closed by the request ahead of this one
+            if (pipelineTail == nullptr) releaseClient(client, host, parsedUrl.port, parsedUrl.tls, false);
+            return HttpRequstStatus::Failed_UnableToConnectToServer;
+        }
+
+        HttpRequest<TClient>* request = addRequest(client, host, parsedUrl.port, parsedUrl.tls, idempotent, options, requestId, onRequestCompleted, onHeaders, onBodyChunk);
+        if (cacheable) keepUrl(request, parsedUrl, endpoint, true);
+#if HTTP_ENABLE_METRICS
+        request->sentUS = micros();
+        request->timings.connectUs = sendStartUS - connectStartUS;
+        request->timings.sendUs = request->sentUS - sendStartUS;
+#endif
+        if (pipelineTail != nullptr) {
+            pipelineTail->pipelineNext = request;
+            request->waitingForPipeline = true;
+        }
+        return HttpRequstStatus::Sent;
+    }
+
+    /**
+     * Takes a free slot and adds the request to the list of pending requests.
+     */
+    HttpRequest<TClient>* addRequest(TClient* client, const char* host, uint16_t port, bool tls, bool idempotent, const HttpRequestOptions& options, uint32_t requestId,
+                                     RequestCompletedCallback* onRequestCompleted, ResponseHeadersCallback* onHeaders, ResponseBodyChunkCallback* onBodyChunk) {
+        HttpRequest<TClient>* request = freeRequests.first();
+        freeRequests.remove(request);
+        request->reset();
+        request->requestStartTS = millis();
+        request->acceptedTS = request->requestStartTS;
+        request->connectTimeoutMs = options.connectTimeoutMs;
+        request->firstByteTimeoutMs = options.firstByteTimeoutMs;
+        request->timeoutMs = options.timeoutMs;
+        request->client = client;
+        strcpy(request->host, host);
+        request->port = port;
+        request->tls = tls;
+        request->idempotent = idempotent;
+        request->callback = onRequestCompleted;
+        request->requestId = requestId;
+        request->userContext = options.userContext;
+        request->headers = options.headers;
+        request->compressBody = options.compressBody;
+        request->acceptCompressed = options.acceptCompressed;
+        request->parser.response.requestId = requestId;
+        request->parser.response.userContext = options.userContext;
+        request->parser.setStreamCallbacks(onHeaders, onBodyChunk);
+        request->parser.setHeaderTable(&responseHeaders);
+        request->parser.setDecompress(decompressResponses);
+        if (onBodyChunk == nullptr && options.jsonDocument != nullptr) {
+            request->jsonDocument = options.jsonDocument;
+            request->jsonFilter = options.jsonFilter;
+            request->parser.setPullBody(true);
+        }
+        HTTP_METRICS(++metrics.requests);
+        pendingRequests.add(request);
+        return request;
+    }
+
+    /**
+     * Takes the next step of a request on a new connection: first the host is resolved, then the
+     * client connects and the request is written, followed by the requests pipelined behind it.
+     * Resolved addresses and failed lookups are cached for later connections, endpoints keep their own address.
+     * Returns false if the request could not be sent.
+     */
+    bool advanceConnection(HttpRequest<TClient>* request) {
+        HTTP_METRICS(unsigned long stepStartUS = micros());
+        HttpEndpoint* endpoint = request->endpoint;
+
+        if (request->state == RequestResolving) {
+            unsigned long ts = millis();
+            HttpDnsCacheResult cached = dnsCache.lookup(request->host, ts, request->address);
+            if (cached == DnsCacheNegativeHit) return false;
+
+            if (cached == DnsCacheHit) {
+                request->hasAddress = true;
+            }
+            else if (resolveHost(request->host, request->address)) {
+                request->hasAddress = true;
+                dnsCache.store(request->host, request->address, ts);
+                // an address from the DNS cache would outlive its TTL if the endpoint restarted it
+                if (endpoint != nullptr) endpoint->setAddress(request->address, ts);
+            }
+            else {
+                // without an address the client resolves the host itself when it connects
+                dnsCache.storeFailure(request->host, ts);
+            }
+
+            request->state = RequestConnecting;
+            HTTP_METRICS(request->timings.connectUs += micros() - stepStartUS);
+            return true;
+        }
+
+        // an attempt does not outlast the connect deadline of the request
+        unsigned long timeoutMs = connectTimeoutMs;
+        if (request->connectTimeoutMs > 0) {
+            unsigned long elapsedMs = millis() - request->requestStartTS;
+            unsigned long remainingMs = elapsedMs < request->connectTimeoutMs ? request->connectTimeoutMs - elapsedMs : 1;
+            if (remainingMs < timeoutMs) timeoutMs = remainingMs;
+        }
+
+        TClient* client = request->client;
+        bool connected;
+        if (request->tls) {
+            connected = connectSecureClient(static_cast<TSecureClient*>(client), request->host, request->port, timeoutMs);
+        }
+        else if (request->hasAddress) {
+            connected = connectClient(client, request->address, request->port, timeoutMs);
+        }
+        else {
+            connected = connectClient(client, request->host, request->port, timeoutMs);
+        }
+        if (!connected) {
+            // the host might have moved to another address
+            if (request->hasAddress) dnsCache.invalidate(request->host);
+            if (endpoint != nullptr) endpoint->invalidateAddress();
+            return false;
+        }
+        // the client resolved the host itself, so the failed lookup does not have to be remembered
+        if (!request->hasAddress && !request->tls) dnsCache.invalidate(request->host);
+        HTTP_METRICS(request->timings.connectUs += micros() - stepStartUS);
+
+        if (!writeKeptRequest(request)) return false;
+
+        for (HttpRequest<TClient>* next = request->pipelineNext; next != nullptr; next = next->pipelineNext) {
+            if (!writeKeptRequest(next)) {
+                // the requests behind it fail once this one is complete
+                request->discardedBytes = true;
+                break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Sends a GET request again on a free client, e.g. after a 304 Not Modified for a response that was
+     * dropped from the cache. It is written right away on an open connection, otherwise from loop().
+     */
+    HttpRequstStatus resendRequest(HttpRequest<TClient>* request) {
+        HttpEndpoint* endpoint = request->endpoint;
+        UrlView url = endpoint != nullptr ? endpoint->getUrl() : UrlView(request->getUrl());
+        bool isConnected;
+        TClient* client = acquireClient(url, isConnected);
+        if (client == nullptr) return HttpRequstStatus::Failed_TooManyConcurrentRequests;
+
+        request->client = client;
+        request->retried = true;
+        request->method = "GET";
+        request->contentType = nullptr;
+        request->receivedFirstByte = false;
+        request->discardedBytes = false;
+        request->parser.reset();
+        request->requestStartTS = millis();
+        request->state = RequestConnecting;
+        if (!isConnected) return HttpRequstStatus::Sent;
+
+        if (!writeKeptRequest(request)) {
+            releaseClient(client, request->host, request->port, request->tls, false);
+            request->client = nullptr;
+            return HttpRequstStatus::Failed_UnableToConnectToServer;
+        }
+        return HttpRequstStatus::Sent;
+    }
+
+    /**
+     * Writes a request that was kept while its connection was being established and frees the kept copies.
+     */
+    bool writeKeptRequest(HttpRequest<TClient>* request) {
+        HTTP_METRICS(unsigned long sendStartUS = micros());
+        HttpEndpoint* endpoint = request->endpoint;
+        if (!writeRequest(request->client, endpoint != nullptr ? endpoint->getUrl() : UrlView(request->getUrl()), endpoint,
+                          request->method, request->contentType, request->headers, request->cacheable, request->compressBody, request->acceptCompressed,
+                          request->hasBody ? request->getBody() : nullptr, request->getBodyLength(), request->hasBodySource ? &request->bodySource : nullptr)) {
+            return false;
+        }
+
+        request->releasePayload();
+        request->state = RequestAwaitingResponse;
+        request->requestStartTS = millis();
+#if HTTP_ENABLE_METRICS
+        request->sentUS = micros();
+        request->timings.sendUs = request->sentUS - sendStartUS;
+#endif
+        return true;
+    }
+
+    /**
+     * Keeps the URL in the request slot (or on the heap if it is longer than HTTP_MAX_URL_LENGTH),
+     * unless the request goes to an endpoint which holds its own copy.
+     */
+    void keepUrl(HttpRequest<TClient>* request, const UrlView& parsedUrl, HttpEndpoint* endpoint, bool cacheable) {
+        request->endpoint = endpoint;
+        request->cacheable = cacheable;
+        if (endpoint == nullptr) request->keepUrl(parsedUrl.url);
+    }
+
+    /**
+     * Keeps the source of a body for a request that is written later. A JSON document passed to post()
+     * or put() is serialized into the kept body, other sources have to stay usable until the request is complete.
+     */
+    void keepBodySource(const HttpRequestBody* bodySource, String& body, bool& hasBody, HttpRequestBody& keptSource, bool& hasKeptSource) {
+        if (bodySource == nullptr) return;
+
+        if (bodySource->type == BodyJson && bodySource->copyWhenKept) {
+            serializeJson(*bodySource->json, body);
+            hasBody = true;
+        }
+        else {
+            keptSource = *bodySource;
+            hasKeptSource = true;
+        }
+    }
+
+    /**
+     * Serializes request line, headers and body into the transmit buffer and writes them to the
+     * client with as few writes as possible. A body source is read straight into the transmit buffer,
+     * with chunked transfer encoding if its length is not known. A compressed body source is always chunked.
+     */
+    bool writeRequest(TClient* client, const UrlView& parsedUrl, HttpEndpoint* endpoint, const char* method, const char* contentType, const HttpHeaders* headers,
+                      bool conditional, bool compressBody, bool acceptCompressed, const char* body, size_t length, const HttpRequestBody* bodySource) {
+        HttpRequestWriter writer(*client, requestBuffer, HTTP_REQUEST_BUFFER_SIZE);
+
+        writer.write(method);
+        if (endpoint != nullptr) {
+            writer.write(endpoint->getRequestLineTail());
+        }
+        else {
+            writer.write(" ", 1);
+            // the request target always starts with a '/', even if the URL has no path
+            if (parsedUrl.pathLength() == 0) writer.write("/", 1);
+            writer.write(parsedUrl.target(), parsedUrl.targetLength());
+            writer.write(" HTTP/1.1\r\nHost: ");
+            writer.write(parsedUrl.host(), parsedUrl.hostLength());
+            if (!parsedUrl.isDefaultPort()) {
+                writer.write(":", 1);
+                writer.writeNumber(parsedUrl.port);
+            }
+            writer.write("\r\n", 2);
+        }
+        writer.writeHeader("Connection", keepAlive ? "keep-alive" : "close");
+        // a window smaller than the one of zlib cannot inflate every compressed body
+        if (decompressResponses && (HTTP_INFLATE_WINDOW_BITS == 15 || acceptCompressed)) {
+            writer.writeHeader("Accept-Encoding", "gzip, deflate");
+        }
+        if (defaultHeaders != nullptr) {
+            writer.write(defaultHeaders->getBlock(), defaultHeaders->getLength());
+        }
+        if (headers != nullptr) {
+            writer.write(headers->getBlock(), headers->getLength());
+        }
+
+        const char* etag;
+        const char* lastModified;
+        if (conditional && responseCache.getValidators(parsedUrl.url, etag, lastModified)) {
+            if (etag != nullptr) writer.writeHeader("If-None-Match", etag);
+            if (lastModified != nullptr) writer.writeHeader("If-Modified-Since", lastModified);
+        }
+
+        int32_t bodyLength = -1;
+        if (body != nullptr || bodySource != nullptr) {
+            if (contentType != nullptr) {
+                writer.writeHeader("Content-Type", contentType);
+            }
+            if (compressBody) {
+                writer.writeHeader("Content-Encoding", "gzip");
+            }
+            else {
+                bodyLength = body != nullptr ? (int32_t)length : bodySource->measure();
+            }
+            if (bodyLength >= 0) {
+                writer.write("Content-Length: ");
+                writer.writeNumber(bodyLength);
+                writer.write("\r\n", 2);
+            }
+            else {
+                writer.writeHeader("Transfer-Encoding", "chunked");
+            }
+        }
+        writer.write("\r\n", 2);
+
+        if (compressBody && body != nullptr) {
+            // a String body was sent uncompressed by sendRequest(), this is the copy of a JSON document
+            writer.writeCompressedBody(body, length);
+        }
+        else if (compressBody) {
+            writer.writeCompressedBody(*bodySource);
+        }
+        else if (body != nullptr) {
+            writer.write(body, length);
+        }
+        else if (bodySource != nullptr) {
+            writer.writeBody(*bodySource, bodyLength);
+        }
+
+        bool written = writer.flush();
+        HTTP_METRICS(metrics.bytesSent += writer.getBytesWritten());
+        return written;
     }
 
-};
+};
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpBodyStream.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HttpResponseParsing.h"
+
+// How long reading a JSON body waits for the next bytes to arrive before deserialization fails
+#ifndef HTTP_JSON_STREAM_TIMEOUT_MS
+#define HTTP_JSON_STREAM_TIMEOUT_MS 1000
+#endif
+
+// How long reading a JSON body may block loop() in total, even if the request has a later deadline.
+// Kept short so a slow body fails instead of stalling the sketch; raise it for slow networks.
+#ifndef HTTP_JSON_STREAM_MAX_WAIT_MS
+#define HTTP_JSON_STREAM_MAX_WAIT_MS 200
+#endif
+
+/**
+ * Reads the body of a response as a Stream, e.g. for deserializeJson(). Received bytes are passed
+ * through the response parser in pull mode, so chunk framing is removed and reading stops at the
+ * end of the body. Bytes that were received already but not parsed yet are read first.
+ *
+ * Reading blocks until the next bytes arrive or HTTP_JSON_STREAM_TIMEOUT_MS has passed. Once
+ * maxWaitMs have passed since the stream was created, it stops waiting and reports a timeout.
+ * It also stops as soon as the request ID is cleared by Http::cancel().
+ */
+template<typename TClient>
+class HttpBodyStream : public Stream {
+    public:
+        /// @param pending Received bytes that have not been passed to the parser yet
+        /// @param buffer The buffer further bytes are read into, it may hold the pending bytes
+        /// @param requestId The ID of the request, reading stops once it is 0
+        /// @param maxWaitMs How long reading may take in total
+        HttpBodyStream(HttpResponseParser& parser, TClient& client, const char* pending, size_t pendingLength, uint8_t* buffer, size_t bufferSize,
+                       const uint32_t& requestId, unsigned long maxWaitMs) :
+            parser(parser), client(client), pending(pending), pendingLength(pendingLength), buffer(buffer), bufferSize(bufferSize),
+            slice(nullptr), sliceLength(0), bytesRead(0), requestId(requestId), createdTS(millis()), maxWaitMs(maxWaitMs), timedOut(false) {
+            // read() waits on its own, readBytes() must not wait again after the end of the body
+            setTimeout(0);
+        }
+
+        int available() override {
+            return fill(false) ? (int)sliceLength : 0;
+        }
+
+        int read() override {
+            if (!fill(true)) return -1;
+            --sliceLength;
+            return (uint8_t)*slice++;
+        }
+
+        int peek() override {
+            return fill(true) ? (uint8_t)*slice : -1;
+        }
+
+        size_t write(uint8_t) override {
+            return 0;
+        }
+
+        /// @brief Gets the received bytes that have not been passed to the parser, e.g. the start of a pipelined response.
+        const char* getPending(size_t& length) const {
+            length = pendingLength;
+            return pending;
+        }
+
+        /// @brief The number of bytes read from the client.
+        size_t getBytesRead() const {
+            return bytesRead;
+        }
+
+        /// @brief Whether reading stopped because the next bytes or the end of the body took too long.
+        bool hasTimedOut() const {
+            return timedOut;
+        }
+
+    private:
+        HttpResponseParser& parser;
+        TClient& client;
+        const char* pending;
+        size_t pendingLength;
+        uint8_t* buffer;
+        size_t bufferSize;
+        const char* slice;
+        size_t sliceLength;
+        size_t bytesRead;
+        const uint32_t& requestId;
+        unsigned long createdTS;
+        unsigned long maxWaitMs;
+        bool timedOut;
+
+        // Makes the next slice of the body available
+        bool fill(bool wait) {
+            unsigned long startTS = millis();
+
+            while (sliceLength == 0) {
+                if (parser.isDone() || timedOut) return false;
+
+                if (pendingLength == 0 && !parser.hasPendingBody() && !receive()) {
+                    if (!client.connected()) {
+                        parser.finish();
+                        return false;
+                    }
+                    if (!wait || requestId == 0) return false;
+
+                    unsigned long ts = millis();
+                    if (ts - startTS >= HTTP_JSON_STREAM_TIMEOUT_MS || ts - createdTS >= maxWaitMs) {
+                        timedOut = true;
+                        return false;
+                    }
+                    yield();
+                    continue;
+                }
+
+                size_t consumed = parser.consume(pending, pendingLength);
+                pending += consumed;
+                pendingLength -= consumed;
+                slice = parser.getBodySlice(sliceLength);
+            }
+            return true;
+        }
+
+        bool receive() {
+            int available = client.available();
+            if (available <= 0) return false;
+
+            size_t length = (size_t)available < bufferSize ? (size_t)available : bufferSize;
+            int result = client.read(buffer, length);
+            if (result <= 0) return false;
+
+            pending = (const char*)buffer;
+            pendingLength = (size_t)result;
+            bytesRead += pendingLength;
+            return true;
+        }
+};
@@ -13,4 +13,13 @@
 
 #include "HttpResponse.h"
 
-typedef void (RequestCompletedCallback)(HttpResponse& response);
\ No newline at end of file
+typedef void (RequestCompletedCallback)(HttpResponse& response);
+
+// Invoked once the status line and headers of a streamed response have been received.
+typedef void (ResponseHeadersCallback)(HttpResponse& response);
+
+// Invoked for every slice of a streamed response body. The data points into the receive buffer and is only valid during the call.
+typedef void (ResponseBodyChunkCallback)(HttpResponse& response, const uint8_t* data, size_t length);
+
+// Produces the next slice of a streamed request body into buffer (at most size bytes). Returns the number of bytes produced, 0 at the end of the body.
+typedef size_t (RequestBodyChunkCallback)(uint8_t* buffer, size_t size);
\ No newline at end of file
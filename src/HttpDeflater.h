@@ -0,0 +1,253 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpDeflater.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// Size of the window matches are searched in as a power of two (9 to 14). The compressor allocates
+// twice the window plus the hash table while a body is written.
+#ifndef HTTP_DEFLATE_WINDOW_BITS
+#define HTTP_DEFLATE_WINDOW_BITS 10
+#endif
+
+// Number of hash table entries as a power of two, each entry takes 2 bytes
+#ifndef HTTP_DEFLATE_HASH_BITS
+#define HTTP_DEFLATE_HASH_BITS 9
+#endif
+
+#if HTTP_DEFLATE_WINDOW_BITS < 9 || HTTP_DEFLATE_WINDOW_BITS > 14
+#error "HTTP_DEFLATE_WINDOW_BITS has to be between 9 and 14"
+#endif
+
+/**
+ * Streaming gzip compressor (RFC 1951 and 1952) for request bodies.
+ *
+ * Bytes written to it are collected in a window and compressed as soon as enough of them are ahead
+ * of the current position to find the longest possible match. Matches are looked up with a single
+ * hash table entry per 3 byte sequence and encoded with the fixed Huffman codes, which needs no
+ * code tables and works well for repetitive text like JSON. The compressed bytes are passed on to
+ * the output as they are produced, so neither the body nor its compressed form is buffered.
+ */
+class HttpDeflater : public Print {
+    public:
+        explicit HttpDeflater(Print& out) :
+            out(out), window(new uint8_t[2 * WindowSize]), head(new uint16_t[HashSize]), start(0), end(0),
+            crc(0xFFFFFFFF), inputLength(0), bitBuffer(0), bitCount(0), pendingLength(0) {
+            if (head != nullptr) {
+                for (size_t i = 0; i < HashSize; ++i) head[i] = NoPosition;
+            }
+
+            // gzip header without name or time, followed by the start of a block with fixed codes
+            static const uint8_t gzipHeader[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+            for (uint8_t i = 0; i < sizeof(gzipHeader); ++i) putByte(gzipHeader[i]);
+            putBits(2, 3);
+        }
+
+        ~HttpDeflater() {
+            delete[] window;
+            delete[] head;
+        }
+
+        HttpDeflater(const HttpDeflater&) = delete;
+        HttpDeflater& operator=(const HttpDeflater&) = delete;
+
+        /// @brief Whether the window and hash table could not be allocated.
+        bool hasFailed() const {
+            return window == nullptr || head == nullptr;
+        }
+
+        size_t write(uint8_t c) override {
+            return write(&c, 1);
+        }
+
+        size_t write(const uint8_t* data, size_t length) override {
+            size_t remaining = length;
+            while (remaining > 0) {
+                size_t space;
+                uint8_t* input = getInputSpace(space);
+                size_t count = remaining < space ? remaining : space;
+                memcpy(input, data, count);
+                commitInput(count);
+                data += count;
+                remaining -= count;
+            }
+            return length;
+        }
+
+        /// @brief Gets the free part of the window, so a source can be read into it directly.
+        /// @param space Receives the number of bytes that can be written
+        uint8_t* getInputSpace(size_t& space) {
+            if (end == 2 * WindowSize) slide();
+            space = 2 * WindowSize - end;
+            return window + end;
+        }
+
+        /// @brief Compresses what can be compressed after count bytes were written into the input space.
+        void commitInput(size_t count) {
+            updateCrc(window + end, count);
+            end += count;
+            inputLength += count;
+            compress(false);
+        }
+
+        /// @brief Compresses the rest of the input and writes the gzip trailer.
+        void finish() {
+            compress(true);
+
+            // end of block, followed by an empty final block
+            putBits(0, 7);
+            putBits(3, 3);
+            putBits(0, 7);
+            if (bitCount > 0) putBits(0, 8 - bitCount);
+
+            uint32_t checksum = ~crc;
+            for (uint8_t i = 0; i < 4; ++i) putByte(checksum >> (8 * i));
+            for (uint8_t i = 0; i < 4; ++i) putByte(inputLength >> (8 * i));
+            flushPending();
+        }
+
+    private:
+        static const size_t WindowSize = (size_t)1 << HTTP_DEFLATE_WINDOW_BITS;
+        static const size_t HashSize = (size_t)1 << HTTP_DEFLATE_HASH_BITS;
+        static const uint16_t NoPosition = 0xFFFF;
+        static const uint8_t MinMatchLength = 3;
+        static const uint16_t MaxMatchLength = 258;
+
+        Print& out;
+        uint8_t* window;   // two windows: the one matches are searched in and the one being filled
+        uint16_t* head;    // last position of each hashed 3 byte sequence
+        size_t start;      // next byte to compress
+        size_t end;        // end of the input
+        uint32_t crc;
+        uint32_t inputLength;
+        uint32_t bitBuffer;
+        uint8_t bitCount;
+        uint8_t pending[32];
+        uint8_t pendingLength;
+
+        // Encodes the input, keeping a full match length of bytes ahead unless the input is complete
+        void compress(bool all) {
+            while (end - start >= (all ? 1 : MaxMatchLength)) {
+                size_t available = end - start;
+                uint16_t length = 0;
+                uint16_t distance = 0;
+
+                if (available >= MinMatchLength) {
+                    uint16_t& entry = head[hash(window + start)];
+                    // until the window slides, the hash table still refers to positions up to two windows back
+                    if (entry != NoPosition && start - entry <= WindowSize) {
+                        size_t limit = available < MaxMatchLength ? available : MaxMatchLength;
+                        const uint8_t* candidate = window + entry;
+                        const uint8_t* current = window + start;
+                        while (length < limit && candidate[length] == current[length]) ++length;
+                        distance = start - entry;
+                    }
+                    entry = start;
+                }
+
+                if (length < MinMatchLength) {
+                    putLiteral(window[start++]);
+                    continue;
+                }
+
+                putMatch(length, distance);
+                // the positions inside the match can be referred to as well
+                for (size_t position = start + 1; position < start + length && position + MinMatchLength <= end; ++position) {
+                    head[hash(window + position)] = position;
+                }
+                start += length;
+            }
+        }
+
+        // Moves the second window to the front once both are full
+        void slide() {
+            memmove(window, window + WindowSize, WindowSize);
+            start -= WindowSize;
+            end -= WindowSize;
+            for (size_t i = 0; i < HashSize; ++i) {
+                head[i] = head[i] != NoPosition && head[i] >= WindowSize ? head[i] - WindowSize : NoPosition;
+            }
+        }
+
+        static uint16_t hash(const uint8_t* data) {
+            uint32_t sequence = data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16);
+            return (uint32_t)(sequence * 2654435761UL) >> (32 - HTTP_DEFLATE_HASH_BITS);
+        }
+
+        void putLiteral(uint8_t value) {
+            if (value < 144) putCode(0x30 + value, 8);
+            else putCode(0x190 + value - 144, 9);
+        }
+
+        void putMatch(uint16_t length, uint16_t distance) {
+            static const uint16_t lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static const uint8_t lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+            static const uint16_t distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                                      1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+            static const uint8_t distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+            uint8_t code = 28;
+            while (lengthBase[code] > length) --code;
+            uint16_t symbol = 257 + code;
+            if (symbol < 280) putCode(symbol - 256, 7);
+            else putCode(0xC0 + symbol - 280, 8);
+            putBits(length - lengthBase[code], lengthExtra[code]);
+
+            code = 29;
+            while (distanceBase[code] > distance) --code;
+            putCode(code, 5);
+            putBits(distance - distanceBase[code], distanceExtra[code]);
+        }
+
+        // Huffman codes are sent starting with their most significant bit
+        void putCode(uint16_t code, uint8_t length) {
+            uint16_t reversed = 0;
+            for (uint8_t i = 0; i < length; ++i) {
+                reversed = (reversed << 1) | (code & 1);
+                code >>= 1;
+            }
+            putBits(reversed, length);
+        }
+
+        void putBits(uint32_t value, uint8_t count) {
+            bitBuffer |= value << bitCount;
+            bitCount += count;
+            while (bitCount >= 8) {
+                putByte(bitBuffer & 0xFF);
+                bitBuffer >>= 8;
+                bitCount -= 8;
+            }
+        }
+
+        void putByte(uint8_t value) {
+            pending[pendingLength++] = value;
+            if (pendingLength == sizeof(pending)) flushPending();
+        }
+
+        void flushPending() {
+            out.write(pending, pendingLength);
+            pendingLength = 0;
+        }
+
+        // CRC-32 as used by gzip, computed with a table of 16 entries per half byte
+        void updateCrc(const uint8_t* data, size_t length) {
+            static const uint32_t table[16] = {
+                0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+                0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+            };
+            for (size_t i = 0; i < length; ++i) {
+                crc ^= data[i];
+                crc = (crc >> 4) ^ table[crc & 0x0F];
+                crc = (crc >> 4) ^ table[crc & 0x0F];
+            }
+        }
+};
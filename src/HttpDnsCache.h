@@ -0,0 +1,166 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpDnsCache.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "UrlParsing.h"
+
+// Number of host names whose addresses are remembered (0 disables the cache)
+#ifndef HTTP_DNS_CACHE_SIZE
+#define HTTP_DNS_CACHE_SIZE 4
+#endif
+
+// How long a resolved address is used before the host is looked up again
+#ifndef HTTP_DNS_CACHE_TTL_MS
+#define HTTP_DNS_CACHE_TTL_MS 300000
+#endif
+
+// How long requests to a host that could not be resolved fail without another lookup
+#ifndef HTTP_DNS_NEGATIVE_TTL_MS
+#define HTTP_DNS_NEGATIVE_TTL_MS 10000
+#endif
+
+enum HttpDnsCacheResult {
+    DnsCacheMiss = 0,        // the host has to be looked up
+    DnsCacheHit = 1,         // the address of the host is known
+    DnsCacheNegativeHit = 2  // the host could not be resolved recently
+};
+
+/**
+ * Remembers the addresses of recently resolved host names, and the host names that could not be
+ * resolved, for a fixed time. The Arduino DNS clients do not report the TTL of a record, so all
+ * entries expire after the same configurable time. When the cache is full, the entry that
+ * expires first is replaced.
+ */
+class HttpDnsCache {
+public:
+    HttpDnsCache() : ttlMs(HTTP_DNS_CACHE_TTL_MS), negativeTtlMs(HTTP_DNS_NEGATIVE_TTL_MS) {
+        clear();
+    }
+
+    /// @brief Looks up a host name.
+    /// @param address Receives the address on a hit
+    HttpDnsCacheResult lookup(const char* host, unsigned long ts, IPAddress& address) const {
+        int8_t index = indexOf(host, ts);
+        if (index < 0) return DnsCacheMiss;
+
+        const Entry& entry = entries[index];
+        if (entry.failed) return DnsCacheNegativeHit;
+        address = entry.address;
+        return DnsCacheHit;
+    }
+
+    /// @brief Remembers the address a host name resolved to.
+    void store(const char* host, const IPAddress& address, unsigned long ts) {
+        Entry* entry = slotFor(host, ts, ttlMs);
+        if (entry == nullptr) return;
+        entry->address = address;
+        entry->failed = false;
+    }
+
+    /// @brief Remembers that a host name could not be resolved.
+    void storeFailure(const char* host, unsigned long ts) {
+        Entry* entry = slotFor(host, ts, negativeTtlMs);
+        if (entry == nullptr) return;
+        entry->failed = true;
+    }
+
+    /// @brief Forgets a host name, e.g. after connecting to its cached address failed.
+    void invalidate(const char* host) {
+        for (uint8_t i = 0; i < HTTP_DNS_CACHE_SIZE; ++i) {
+            if (entries[i].host[0] != '\0' && strcasecmp(entries[i].host, host) == 0) {
+                entries[i].host[0] = '\0';
+            }
+        }
+    }
+
+    void clear() {
+        for (uint8_t i = 0; i < HTTP_DNS_CACHE_SIZE; ++i) {
+            entries[i].host[0] = '\0';
+        }
+    }
+
+    /// @brief Sets how long resolved addresses are kept (0 disables caching them). Drops all entries.
+    void setTtlMs(unsigned long ttlMs) {
+        this->ttlMs = ttlMs;
+        clear();
+    }
+
+    unsigned long getTtlMs() const {
+        return ttlMs;
+    }
+
+    /// @brief Sets how long lookup failures are kept (0 disables negative caching). Drops all entries.
+    void setNegativeTtlMs(unsigned long negativeTtlMs) {
+        this->negativeTtlMs = negativeTtlMs;
+        clear();
+    }
+
+    unsigned long getNegativeTtlMs() const {
+        return negativeTtlMs;
+    }
+
+private:
+    struct Entry {
+        char host[HTTP_MAX_HOST_LENGTH + 1];
+        IPAddress address;
+        bool failed;
+        unsigned long storedTS;
+        unsigned long ttlMs;
+
+        bool isValid(unsigned long ts) const {
+            return host[0] != '\0' && ts - storedTS < ttlMs;
+        }
+    };
+
+    Entry entries[HTTP_DNS_CACHE_SIZE > 0 ? HTTP_DNS_CACHE_SIZE : 1];
+    unsigned long ttlMs;
+    unsigned long negativeTtlMs;
+
+    int8_t indexOf(const char* host, unsigned long ts) const {
+        for (uint8_t i = 0; i < HTTP_DNS_CACHE_SIZE; ++i) {
+            if (entries[i].isValid(ts) && strcasecmp(entries[i].host, host) == 0) return i;
+        }
+        return -1;
+    }
+
+    // Finds the entry of the host or the one to replace: an unused or expired one, otherwise the one expiring first
+    Entry* slotFor(const char* host, unsigned long ts, unsigned long entryTtlMs) {
+        if (HTTP_DNS_CACHE_SIZE == 0 || strlen(host) > HTTP_MAX_HOST_LENGTH) return nullptr;
+        if (entryTtlMs == 0) {
+            invalidate(host);
+            return nullptr;
+        }
+
+        Entry* slot = nullptr;
+        unsigned long slotRemainingMs = 0;
+        for (uint8_t i = 0; i < HTTP_DNS_CACHE_SIZE; ++i) {
+            Entry& entry = entries[i];
+            if (entry.host[0] != '\0' && strcasecmp(entry.host, host) == 0) {
+                slot = &entry;
+                break;
+            }
+
+            unsigned long remainingMs = entry.isValid(ts) ? entry.ttlMs - (ts - entry.storedTS) : 0;
+            if (slot == nullptr || remainingMs < slotRemainingMs) {
+                slot = &entry;
+                slotRemainingMs = remainingMs;
+            }
+        }
+
+        strcpy(slot->host, host);
+        slot->storedTS = ts;
+        slot->ttlMs = entryTtlMs;
+        return slot;
+    }
+};
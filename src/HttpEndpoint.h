@@ -0,0 +1,107 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpEndpoint.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "UrlParsing.h"
+
+/**
+ * A URL that is requested repeatedly. The URL is parsed and the request line and Host header are
+ * rendered once when the endpoint is created, and the resolved IP address of the host is kept for
+ * the DNS cache TTL (see Http::setDnsCacheTtlMs()). Create endpoints once (e.g. as globals) and pass them to
+ * get(), post(), put() and del() instead of the URL.
+ *
+ *     HttpEndpoint collector("http://collector.local/ingest");
+ *     http.post(collector, doc, &onPosted);
+ */
+class HttpEndpoint {
+    public:
+        HttpEndpoint(const char* url) : url(url), view(this->url.c_str()), resolvedTS(0), resolved(false) {
+            valid = !view.failed && view.copyHost(host, sizeof(host));
+            if (!valid) {
+                host[0] = '\0';
+                return;
+            }
+
+            // everything of the request line after the method, followed by the Host header
+            requestLineTail.reserve(view.targetLength() + view.hostLength() + 27);
+            requestLineTail.concat(' ');
+            if (view.pathLength() == 0) requestLineTail.concat('/');
+            requestLineTail.concat(view.target(), view.targetLength());
+            requestLineTail.concat(" HTTP/1.1\r\nHost: ");
+            requestLineTail.concat(host);
+            if (!view.isDefaultPort()) {
+                requestLineTail.concat(':');
+                requestLineTail.concat(String(view.port));
+            }
+            requestLineTail.concat("\r\n");
+        }
+
+        HttpEndpoint(const String& url) : HttpEndpoint(url.c_str()) {}
+
+        // the view points into this endpoint's copy of the URL, so endpoints must not be copied
+        HttpEndpoint(const HttpEndpoint&) = delete;
+        HttpEndpoint& operator=(const HttpEndpoint&) = delete;
+
+        bool isValid() const {
+            return valid;
+        }
+
+        const UrlView& getUrl() const {
+            return view;
+        }
+
+        const char* getHost() const {
+            return host;
+        }
+
+        uint16_t getPort() const {
+            return view.port;
+        }
+
+        /// @brief The request line without the method (" /path HTTP/1.1\r\n") followed by the Host header.
+        const String& getRequestLineTail() const {
+            return requestLineTail;
+        }
+
+        /// @brief Whether the host was resolved less than ttlMs before ts.
+        bool isResolved(unsigned long ts, unsigned long ttlMs) const {
+            return resolved && ts - resolvedTS < ttlMs;
+        }
+
+        const IPAddress& getAddress() const {
+            return address;
+        }
+
+        /// @brief Keeps the address the host was resolved to at ts.
+        void setAddress(const IPAddress& address, unsigned long ts) {
+            this->address = address;
+            resolvedTS = ts;
+            resolved = true;
+        }
+
+        /// @brief Forgets the resolved address so that it is looked up again on the next request.
+        void invalidateAddress() {
+            resolved = false;
+        }
+
+    private:
+        String url;
+        UrlView view;
+        bool valid;
+        char host[HTTP_MAX_HOST_LENGTH + 1];
+        String requestLineTail;
+        IPAddress address;
+        unsigned long resolvedTS;
+        bool resolved;
+};
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <Ethernet.h>
+#include <Dns.h>
 #include "Http.h"
 
 /**
@@ -28,4 +29,26 @@ public:
         IPAddress ip = Ethernet.localIP();
         return String(ip[0]) + String(".") + String(ip[1]) + String(".") + String(ip[2]) + String(".") + String(ip[3]);
     }
+
+    bool resolveHost(const char* host, IPAddress& address) override {
+        DNSClient dns;
+        dns.begin(Ethernet.dnsServerIP());
+        return dns.getHostByName(host, address) == 1;
+    }
+
+    bool connectClient(EthernetClient* client, const IPAddress& address, uint16_t port, unsigned long timeoutMs) override {
+        setConnectionTimeout(client, timeoutMs);
+        return client->connect(address, port) > 0;
+    }
+
+    bool connectClient(EthernetClient* client, const char* host, uint16_t port, unsigned long timeoutMs) override {
+        setConnectionTimeout(client, timeoutMs);
+        return client->connect(host, port) > 0;
+    }
+
+private:
+    // the W5x00 gives up on the handshake after this time instead of the library default
+    static void setConnectionTimeout(EthernetClient* client, unsigned long timeoutMs) {
+        client->setConnectionTimeout(timeoutMs < 0xFFFF ? (uint16_t)timeoutMs : 0xFFFF);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpHeaderTable.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// Max number of additional response headers that can be captured
+#ifndef HTTP_MAX_RESPONSE_HEADERS
+#define HTTP_MAX_RESPONSE_HEADERS 4
+#endif
+
+// Longest header name that can be matched
+#ifndef HTTP_MAX_HEADER_NAME_LENGTH
+#define HTTP_MAX_HEADER_NAME_LENGTH 32
+#endif
+
+// Space for the values of captured response headers in every response
+#ifndef HTTP_RESPONSE_HEADER_BUFFER_SIZE
+#define HTTP_RESPONSE_HEADER_BUFFER_SIZE 128
+#endif
+
+/**
+ * Names of the response headers whose values are captured in addition to the ones HttpResponse
+ * always provides. Names are matched case-insensitively; length and first character are compared
+ * before the full name, so headers nobody registered are rejected after a single comparison.
+ */
+class HttpHeaderTable {
+public:
+    HttpHeaderTable() : count(0) {}
+
+    /// @brief Registers a header.
+    /// @param name The header name. It is not copied and has to outlive the table (e.g. a string literal).
+    /// @return false if HTTP_MAX_RESPONSE_HEADERS headers are registered already
+    bool add(const char* name) {
+        size_t length = strlen(name);
+        if (length == 0 || length > HTTP_MAX_HEADER_NAME_LENGTH) return false;
+        if (indexOf(name, length) >= 0) return true;
+        if (count >= HTTP_MAX_RESPONSE_HEADERS) return false;
+
+        names[count] = name;
+        lengths[count] = (uint8_t)length;
+        firstChars[count] = toLower(name[0]);
+        ++count;
+        return true;
+    }
+
+    /// @brief Looks up a header name.
+    /// @return The index of the header or -1 if it is not registered
+    int8_t indexOf(const char* name, size_t length) const {
+        char first = toLower(name[0]);
+        for (uint8_t i = 0; i < count; ++i) {
+            if (lengths[i] == length && firstChars[i] == first && equalsIgnoreCase(names[i], name, length)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    uint8_t getSize() const {
+        return count;
+    }
+
+    static char toLower(char c) {
+        return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+
+    static bool equalsIgnoreCase(const char* a, const char* b, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            if (toLower(a[i]) != toLower(b[i])) return false;
+        }
+        return true;
+    }
+
+private:
+    const char* names[HTTP_MAX_RESPONSE_HEADERS > 0 ? HTTP_MAX_RESPONSE_HEADERS : 1];
+    uint8_t lengths[HTTP_MAX_RESPONSE_HEADERS > 0 ? HTTP_MAX_RESPONSE_HEADERS : 1];
+    char firstChars[HTTP_MAX_RESPONSE_HEADERS > 0 ? HTTP_MAX_RESPONSE_HEADERS : 1];
+    uint8_t count;
+};
@@ -0,0 +1,84 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpHeaders.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// Space for the rendered header lines of an HttpHeaders set, enough for a bearer token (JWT) and a few short headers
+#ifndef HTTP_REQUEST_HEADERS_BUFFER_SIZE
+#define HTTP_REQUEST_HEADERS_BUFFER_SIZE 512
+#endif
+
+/**
+ * A set of request headers (e.g. Authorization, Accept) rendered once into a fixed buffer of
+ * "Name: value\r\n" lines. The same set can be attached to any number of requests, which copy
+ * the rendered block into their transmit buffer as a whole.
+ */
+class HttpHeaders {
+public:
+    HttpHeaders() : length(0) {}
+
+    /// @brief Appends a header.
+    /// @return false if the name or value contains characters not allowed in a header or the
+    ///         header does not fit into HTTP_REQUEST_HEADERS_BUFFER_SIZE
+    bool add(const char* name, const char* value) {
+        size_t nameLength = strlen(name);
+        size_t valueLength = strlen(value);
+        if (nameLength == 0 || !isValidName(name) || !isValidValue(value)) return false;
+        if (length + nameLength + valueLength + 4 > HTTP_REQUEST_HEADERS_BUFFER_SIZE) return false;
+
+        append(name, nameLength);
+        append(": ", 2);
+        append(value, valueLength);
+        append("\r\n", 2);
+        return true;
+    }
+
+    void clear() {
+        length = 0;
+    }
+
+    /// @brief Gets the rendered header lines, each terminated by "\r\n" (not null-terminated).
+    const char* getBlock() const {
+        return buffer;
+    }
+
+    size_t getLength() const {
+        return length;
+    }
+
+private:
+    char buffer[HTTP_REQUEST_HEADERS_BUFFER_SIZE];
+    size_t length;
+
+    void append(const char* data, size_t dataLength) {
+        memcpy(buffer + length, data, dataLength);
+        length += dataLength;
+    }
+
+    // Header names are tokens: no separators, spaces or control characters
+    static bool isValidName(const char* name) {
+        for (; *name != '\0'; ++name) {
+            char c = *name;
+            if (c <= ' ' || c >= 127 || strchr("()<>@,;:\\\"/[]?={}", c) != nullptr) return false;
+        }
+        return true;
+    }
+
+    // A line break in a value would start another header
+    static bool isValidValue(const char* value) {
+        for (; *value != '\0'; ++value) {
+            if (*value == '\r' || *value == '\n') return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,641 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpInflater.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// Size of the inflate window as a power of two (8 to 15). Servers may refer back up to 32 KB (15),
+// smaller windows save RAM but fail on responses that refer back further. Boards with plenty of RAM
+// use the full window, others a 4 KB window that fits next to a sketch on 32 KB of RAM.
+#ifndef HTTP_INFLATE_WINDOW_BITS
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+#define HTTP_INFLATE_WINDOW_BITS 15
+#else
+#define HTTP_INFLATE_WINDOW_BITS 12
+#endif
+#endif
+
+#if HTTP_INFLATE_WINDOW_BITS < 8 || HTTP_INFLATE_WINDOW_BITS > 15
+#error "HTTP_INFLATE_WINDOW_BITS has to be between 8 and 15"
+#endif
+
+enum HttpContentEncoding {
+    EncodingIdentity = 0,
+    EncodingGzip = 1,
+    EncodingDeflate = 2,  // zlib stream, raw deflate data is accepted as well
+    EncodingUnsupported = 3
+};
+
+/**
+ * Streaming inflater for gzip and deflate encoded response bodies (RFC 1951, 1950 and 1952).
+ *
+ * Compressed bytes can be passed in arbitrary slices; the decoder keeps its position down to the
+ * bit and continues with the next slice. The decompressed bytes are written into the window, which
+ * holds the history the compressed data refers back to, and are handed out directly from there.
+ * Neither the compressed nor the decompressed body is buffered. The CRC-32 and length of a gzip
+ * stream and the Adler-32 checksum of a zlib stream are verified at its end.
+ */
+class HttpInflater {
+    public:
+        explicit HttpInflater(HttpContentEncoding encoding) :
+            window(new uint8_t[WindowSize + MaxMatchLength]), outPos(0), checkedPos(0), totalOut(0), bitBuffer(0), bitCount(0),
+            in(nullptr), inEnd(nullptr), finalBlock(false), headerBytes(0), gzipFlags(0), skipLength(0),
+            codeCount(0), literalCount(0), distanceCount(0), pendingSymbol(0), copyLength(0), trailerValue(0) {
+            if (encoding == EncodingGzip) {
+                state = StateGzipHeader;
+                wrapper = WrapperGzip;
+                checksum = 0xFFFFFFFF;
+            }
+            else {
+                state = StateZlibHeader;
+                wrapper = WrapperZlib;
+                checksum = 1;
+            }
+            if (window == nullptr) state = StateFailed;
+        }
+
+        ~HttpInflater() {
+            delete[] window;
+        }
+
+        HttpInflater(const HttpInflater&) = delete;
+        HttpInflater& operator=(const HttpInflater&) = delete;
+
+        /// @brief Decompresses the next slice of compressed bytes.
+        /// Stops early once a window worth of bytes has been produced, the rest has to be passed again.
+        /// @param output Receives the decompressed bytes, valid until the next call
+        /// @return The number of compressed bytes consumed
+        size_t inflate(const uint8_t* data, size_t length, const char*& output, size_t& outputLength) {
+            in = data;
+            inEnd = data + length;
+
+            // the bytes written past the end of the window belong to its start
+            if (outPos >= WindowSize) {
+                memmove(window, window + WindowSize, outPos - WindowSize);
+                outPos -= WindowSize;
+                checkedPos = outPos;
+            }
+
+            size_t outStart = outPos;
+            while (outPos < WindowSize && step()) {}
+            updateChecksum();
+
+            output = (const char*)window + outStart;
+            outputLength = outPos - outStart;
+
+            // anything after the end of the stream is skipped
+            if (state == StateDone || state == StateFailed) in = inEnd;
+            return in - data;
+        }
+
+        /// @brief Whether inflate() stopped because the window was full and has more bytes to hand out,
+        /// even if no further compressed bytes are passed.
+        bool isOutputPending() const {
+            return outPos >= WindowSize && state != StateDone && state != StateFailed;
+        }
+
+        /// @brief Whether the end of the stream was reached and its checksum matched.
+        bool isDone() const {
+            return state == StateDone;
+        }
+
+        bool hasFailed() const {
+            return state == StateFailed;
+        }
+
+    private:
+        static const size_t WindowSize = (size_t)1 << HTTP_INFLATE_WINDOW_BITS;
+        static const size_t MaxMatchLength = 258;
+        static const uint8_t MaxCodeLength = 15;
+        static const int NeedMoreBits = -1;
+        static const int InvalidCode = -2;
+
+        enum State {
+            StateGzipHeader,
+            StateZlibHeader,
+            StateBlockHeader,
+            StateStoredLength,
+            StateStored,
+            StateTableHeader,
+            StateCodeLengthCodes,
+            StateCodeLengths,
+            StateCodeLengthRepeat,  // the extra bits of a repeat code
+            StateLiteral,
+            StateLengthExtra,       // the extra bits of a length code
+            StateDistance,
+            StateDistanceExtra,     // the extra bits of a distance code
+            StateTrailer,
+            StateDone,
+            StateFailed
+        };
+
+        enum Wrapper {
+            WrapperGzip,  // followed by CRC-32 and length
+            WrapperZlib,  // followed by Adler-32
+            WrapperRaw    // raw deflate data without checksum
+        };
+
+        // Canonical Huffman code: number of codes per length and the symbols ordered by code
+        template<size_t Symbols>
+        struct HuffmanTable {
+            uint16_t counts[MaxCodeLength + 1];
+            uint16_t symbols[Symbols];
+        };
+
+        State state;
+        Wrapper wrapper;
+        uint8_t* window;
+        size_t outPos;       // may run up to MaxMatchLength past the window, see inflate()
+        size_t checkedPos;   // end of the bytes that have been added to the checksum
+        uint32_t totalOut;   // bytes produced so far, for checking distances and the gzip length
+        uint32_t checksum;   // CRC-32 (inverted) for gzip, Adler-32 for zlib
+        uint32_t bitBuffer;
+        uint8_t bitCount;
+        const uint8_t* in;
+        const uint8_t* inEnd;
+        bool finalBlock;
+
+        // gzip header
+        uint8_t headerBytes;
+        uint8_t gzipFlags;
+        uint16_t skipLength;
+
+        // tables of the current block
+        HuffmanTable<288> literals;
+        HuffmanTable<30> distances;
+        HuffmanTable<19> codeLengthCodes;
+        uint8_t lengths[288 + 32];
+        uint16_t codeCount;
+        uint16_t literalCount;
+        uint16_t distanceCount;
+
+        uint16_t pendingSymbol;  // decoded symbol whose extra bits are still missing
+        uint16_t copyLength;
+        uint32_t trailerValue;
+
+        // Takes one step, returns false if more input is needed or the stream ended
+        bool step() {
+            switch (state) {
+                case StateGzipHeader:
+                    return gzipHeader();
+                case StateZlibHeader:
+                    return zlibHeader();
+                case StateBlockHeader:
+                    return blockHeader();
+                case StateStoredLength: {
+                    if (!fill(32)) return false;
+                    uint16_t length = take(16);
+                    uint16_t complement = take(16);
+                    if (length != (uint16_t)~complement) return fail();
+                    copyLength = length;
+                    state = StateStored;
+                    return true;
+                }
+                case StateStored:
+                    return stored();
+                case StateTableHeader:
+                    if (!fill(14)) return false;
+                    literalCount = take(5) + 257;
+                    distanceCount = take(5) + 1;
+                    codeCount = take(4) + 4;
+                    if (literalCount > 286 || distanceCount > 30) return fail();
+                    memset(lengths, 0, 19);
+                    headerBytes = 0;
+                    state = StateCodeLengthCodes;
+                    return true;
+                case StateCodeLengthCodes:
+                    return codeLengthCodeLengths();
+                case StateCodeLengths:
+                    return codeLengths();
+                case StateCodeLengthRepeat:
+                    return codeLengthRepeat();
+                case StateLiteral:
+                    return literal();
+                case StateLengthExtra:
+                    return lengthExtra();
+                case StateDistance:
+                    return distance();
+                case StateDistanceExtra:
+                    return distanceExtra();
+                case StateTrailer:
+                    return trailer();
+                default:
+                    return false;
+            }
+        }
+
+        bool gzipHeader() {
+            // fixed part: magic, method, flags, time, extra flags, OS
+            if (headerBytes < 10) {
+                if (!fill(8)) return false;
+                uint8_t value = take(8);
+                if ((headerBytes == 0 && value != 0x1F) || (headerBytes == 1 && value != 0x8B) || (headerBytes == 2 && value != 8)) return fail();
+                if (headerBytes == 3) gzipFlags = value;
+                ++headerBytes;
+                return true;
+            }
+
+            // optional fields in their order: extra data, file name, comment, header checksum
+            if (gzipFlags & 0x04) {
+                if (headerBytes < 12) {
+                    if (!fill(8)) return false;
+                    skipLength |= take(8) << (8 * (headerBytes - 10));
+                    ++headerBytes;
+                    return true;
+                }
+                if (skipLength > 0) {
+                    if (!fill(8)) return false;
+                    take(8);
+                    --skipLength;
+                    return true;
+                }
+                gzipFlags &= ~0x04;
+                return true;
+            }
+            if (gzipFlags & 0x18) {
+                if (!fill(8)) return false;
+                // a zero ends the file name or comment
+                if (take(8) == 0) gzipFlags &= (gzipFlags & 0x08) ? ~0x08 : ~0x10;
+                return true;
+            }
+            if (gzipFlags & 0x02) {
+                if (!fill(16)) return false;
+                take(16);
+                gzipFlags &= ~0x02;
+                return true;
+            }
+
+            state = StateBlockHeader;
+            return true;
+        }
+
+        bool zlibHeader() {
+            if (!fill(16)) return false;
+
+            uint8_t method = bitBuffer & 0xFF;
+            uint8_t flags = (bitBuffer >> 8) & 0xFF;
+            if ((method & 0x0F) == 8 && ((method << 8) | flags) % 31 == 0) {
+                // a preset dictionary cannot be handled. A window larger than the one available only
+                // fails once the data actually refers back further, which short bodies never do.
+                if ((flags & 0x20) || (method >> 4) > 7) return fail();
+                take(16);
+            }
+            else {
+                // the server sent raw deflate data without the zlib wrapper
+                wrapper = WrapperRaw;
+            }
+
+            state = StateBlockHeader;
+            return true;
+        }
+
+        bool blockHeader() {
+            if (!fill(3)) return false;
+            finalBlock = take(1) == 1;
+
+            switch (take(2)) {
+                case 0:
+                    // stored blocks start at a byte boundary
+                    take(bitCount & 7);
+                    state = StateStoredLength;
+                    return true;
+                case 1:
+                    buildFixedTables();
+                    state = StateLiteral;
+                    return true;
+                case 2:
+                    state = StateTableHeader;
+                    return true;
+                default:
+                    return fail();
+            }
+        }
+
+        bool stored() {
+            while (copyLength > 0 && outPos < WindowSize) {
+                uint8_t value;
+                if (bitCount >= 8) {
+                    value = take(8);
+                }
+                else if (in != inEnd) {
+                    value = *in++;
+                }
+                else {
+                    return false;
+                }
+                window[outPos++] = value;
+                ++totalOut;
+                --copyLength;
+            }
+            if (copyLength == 0) endBlock();
+            return true;
+        }
+
+        bool codeLengthCodeLengths() {
+            static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+            while (headerBytes < codeCount) {
+                if (!fill(3)) return false;
+                lengths[order[headerBytes++]] = take(3);
+            }
+            if (!build(codeLengthCodes, lengths, 19)) return fail();
+
+            codeCount = 0;
+            state = StateCodeLengths;
+            return true;
+        }
+
+        // Lengths of the literal/length and distance codes, run-length encoded with the code length codes
+        bool codeLengths() {
+            uint16_t total = literalCount + distanceCount;
+            while (codeCount < total) {
+                fillAll();
+                uint8_t length;
+                int symbol = peekSymbol(codeLengthCodes, length);
+                if (symbol == NeedMoreBits) return false;
+                if (symbol < 0) return fail();
+
+                if (symbol < 16) {
+                    take(length);
+                    lengths[codeCount++] = symbol;
+                    continue;
+                }
+
+                // the extra bits are read in their own step, as they may arrive with the next slice
+                take(length);
+                pendingSymbol = symbol;
+                state = StateCodeLengthRepeat;
+                return true;
+            }
+
+            // the end of block code has to exist
+            if (lengths[256] == 0) return fail();
+            if (!build(literals, lengths, literalCount) || !build(distances, lengths + literalCount, distanceCount)) return fail();
+            state = StateLiteral;
+            return true;
+        }
+
+        // Repeats the previous length (16) or zero (17, 18)
+        bool codeLengthRepeat() {
+            uint8_t extraBits = pendingSymbol == 16 ? 2 : (pendingSymbol == 17 ? 3 : 7);
+            if (!fill(extraBits)) return false;
+
+            uint8_t value = 0;
+            uint16_t repeat;
+            if (pendingSymbol == 16) {
+                if (codeCount == 0) return fail();
+                value = lengths[codeCount - 1];
+                repeat = 3 + take(2);
+            }
+            else if (pendingSymbol == 17) {
+                repeat = 3 + take(3);
+            }
+            else {
+                repeat = 11 + take(7);
+            }
+            if (codeCount + repeat > literalCount + distanceCount) return fail();
+            while (repeat-- > 0) lengths[codeCount++] = value;
+
+            state = StateCodeLengths;
+            return true;
+        }
+
+        bool literal() {
+            fillAll();
+            uint8_t length;
+            int symbol = peekSymbol(literals, length);
+            if (symbol == NeedMoreBits) return false;
+            if (symbol < 0) return fail();
+
+            if (symbol < 256) {
+                take(length);
+                window[outPos++] = symbol;
+                ++totalOut;
+                return true;
+            }
+            if (symbol == 256) {
+                take(length);
+                endBlock();
+                return true;
+            }
+
+            if (symbol - 257 >= 29) return fail();
+            take(length);
+            pendingSymbol = symbol - 257;
+            state = StateLengthExtra;
+            return true;
+        }
+
+        bool lengthExtra() {
+            static const uint16_t lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static const uint8_t lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+            if (!fill(lengthExtra[pendingSymbol])) return false;
+            copyLength = lengthBase[pendingSymbol] + take(lengthExtra[pendingSymbol]);
+            state = StateDistance;
+            return true;
+        }
+
+        bool distance() {
+            fillAll();
+            uint8_t length;
+            int symbol = peekSymbol(distances, length);
+            if (symbol == NeedMoreBits) return false;
+            if (symbol < 0 || symbol >= 30) return fail();
+            take(length);
+            pendingSymbol = symbol;
+            state = StateDistanceExtra;
+            return true;
+        }
+
+        bool distanceExtra() {
+            static const uint16_t distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                                      1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+            static const uint8_t distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+            if (!fill(distanceExtra[pendingSymbol])) return false;
+            size_t distance = distanceBase[pendingSymbol] + take(distanceExtra[pendingSymbol]);
+            if (distance > WindowSize || distance > totalOut) return fail();
+
+            // a match never starts past the end of the window, so it fits into the space behind it
+            for (uint16_t i = 0; i < copyLength; ++i) {
+                size_t source = outPos >= distance ? outPos - distance : outPos + WindowSize - distance;
+                window[outPos++] = window[source];
+            }
+            totalOut += copyLength;
+            state = StateLiteral;
+            return true;
+        }
+
+        void endBlock() {
+            if (!finalBlock) {
+                state = StateBlockHeader;
+                return;
+            }
+
+            // the trailer starts at a byte boundary and covers everything produced so far
+            take(bitCount & 7);
+            updateChecksum();
+            headerBytes = 0;
+            state = wrapper == WrapperRaw ? StateDone : StateTrailer;
+        }
+
+        // gzip: CRC-32 and length, little-endian. zlib: Adler-32, big-endian.
+        bool trailer() {
+            uint8_t trailerLength = wrapper == WrapperGzip ? 8 : 4;
+            while (headerBytes < trailerLength) {
+                if (!fill(8)) return false;
+                uint32_t value = take(8);
+                if (wrapper == WrapperZlib) {
+                    trailerValue = (trailerValue << 8) | value;
+                }
+                else {
+                    trailerValue |= value << (8 * (headerBytes & 3));
+                }
+                ++headerBytes;
+
+                if (wrapper == WrapperGzip && headerBytes == 4) {
+                    if (trailerValue != ~checksum) return fail();
+                    trailerValue = 0;
+                }
+            }
+
+            if (trailerValue != (wrapper == WrapperGzip ? totalOut : checksum)) return fail();
+            state = StateDone;
+            return true;
+        }
+
+        // Adds the bytes produced since the last call to the checksum
+        void updateChecksum() {
+            static const uint32_t crcTable[16] = {
+                0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+                0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+            };
+
+            const uint8_t* data = window + checkedPos;
+            size_t length = outPos - checkedPos;
+            checkedPos = outPos;
+
+            if (wrapper == WrapperGzip) {
+                // CRC-32 with a table of 16 entries per half byte
+                for (size_t i = 0; i < length; ++i) {
+                    checksum ^= data[i];
+                    checksum = (checksum >> 4) ^ crcTable[checksum & 0x0F];
+                    checksum = (checksum >> 4) ^ crcTable[checksum & 0x0F];
+                }
+            }
+            else if (wrapper == WrapperZlib) {
+                // Adler-32, the sums are reduced before they can overflow
+                uint32_t a = checksum & 0xFFFF;
+                uint32_t b = checksum >> 16;
+                while (length > 0) {
+                    size_t block = length < 5552 ? length : 5552;
+                    length -= block;
+                    while (block-- > 0) {
+                        a += *data++;
+                        b += a;
+                    }
+                    a %= 65521;
+                    b %= 65521;
+                }
+                checksum = (b << 16) | a;
+            }
+        }
+
+        bool fail() {
+            state = StateFailed;
+            return false;
+        }
+
+        void buildFixedTables() {
+            memset(lengths, 8, 144);
+            memset(lengths + 144, 9, 112);
+            memset(lengths + 256, 7, 24);
+            memset(lengths + 280, 8, 8);
+            build(literals, lengths, 288);
+
+            memset(lengths, 5, 30);
+            build(distances, lengths, 30);
+        }
+
+        // Builds a canonical Huffman code from code lengths, fails if the lengths are over-subscribed
+        template<size_t Symbols>
+        static bool build(HuffmanTable<Symbols>& table, const uint8_t* codeLengths, uint16_t count) {
+            memset(table.counts, 0, sizeof(table.counts));
+            for (uint16_t symbol = 0; symbol < count; ++symbol) {
+                ++table.counts[codeLengths[symbol]];
+            }
+            table.counts[0] = 0;
+
+            int left = 1;
+            for (uint8_t length = 1; length <= MaxCodeLength; ++length) {
+                left = (left << 1) - table.counts[length];
+                if (left < 0) return false;
+            }
+
+            uint16_t offsets[MaxCodeLength + 1];
+            offsets[1] = 0;
+            for (uint8_t length = 1; length < MaxCodeLength; ++length) {
+                offsets[length + 1] = offsets[length] + table.counts[length];
+            }
+            for (uint16_t symbol = 0; symbol < count; ++symbol) {
+                if (codeLengths[symbol] != 0) table.symbols[offsets[codeLengths[symbol]]++] = symbol;
+            }
+            return true;
+        }
+
+        // Decodes the next symbol without taking its bits
+        template<size_t Symbols>
+        int peekSymbol(const HuffmanTable<Symbols>& table, uint8_t& length) const {
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (uint8_t codeLength = 1; codeLength <= MaxCodeLength; ++codeLength) {
+                if (codeLength > bitCount) return NeedMoreBits;
+
+                code |= (bitBuffer >> (codeLength - 1)) & 1;
+                int count = table.counts[codeLength];
+                if (code - first < count) {
+                    length = codeLength;
+                    return table.symbols[index + code - first];
+                }
+                index += count;
+                first = (first + count) << 1;
+                code <<= 1;
+            }
+            return InvalidCode;
+        }
+
+        bool fill(uint8_t bits) {
+            while (bitCount < bits) {
+                if (in == inEnd) return false;
+                bitBuffer |= (uint32_t)*in++ << bitCount;
+                bitCount += 8;
+            }
+            return true;
+        }
+
+        // Loads as many bytes as fit into the bit buffer
+        void fillAll() {
+            while (bitCount <= 24 && in != inEnd) {
+                bitBuffer |= (uint32_t)*in++ << bitCount;
+                bitCount += 8;
+            }
+        }
+
+        uint32_t take(uint8_t bits) {
+            uint32_t value = bitBuffer & (((uint32_t)1 << bits) - 1);
+            bitBuffer >>= bits;
+            bitCount -= bits;
+            return value;
+        }
+};
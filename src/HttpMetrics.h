@@ -0,0 +1,91 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpMetrics.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// Set to 1 (before including the library) to record request timings and counters, see Http::getMetrics()
+#ifndef HTTP_ENABLE_METRICS
+#define HTTP_ENABLE_METRICS 0
+#endif
+
+// Wraps statements that only exist when metrics are enabled
+#if HTTP_ENABLE_METRICS
+#define HTTP_METRICS(statement) statement
+#else
+#define HTTP_METRICS(statement)
+#endif
+
+#define HTTP_LATENCY_BUCKETS 10
+
+/**
+ * Durations of the phases of a single request in microseconds.
+ * Phases that did not happen (e.g. connecting when a keep-alive connection was reused) are 0.
+ */
+struct HttpRequestTimings {
+    unsigned long connectUs;    // DNS lookup and TCP handshake
+    unsigned long sendUs;       // writing request line, headers and body
+    unsigned long firstByteUs;  // from the end of sending to the first byte of the response
+    unsigned long transferUs;   // from the first to the last byte of the response
+    unsigned long parseUs;      // spent in the response parser, including body chunk callbacks
+    unsigned long totalUs;      // from connecting until the response was complete
+
+    HttpRequestTimings() : connectUs(0), sendUs(0), firstByteUs(0), transferUs(0), parseUs(0), totalUs(0) {}
+};
+
+/**
+ * Counters aggregated over all requests of an Http instance.
+ */
+struct HttpMetrics {
+    uint32_t requests;          // requests that were sent
+    uint32_t completed;         // requests that received a response
+    uint32_t timeouts;          // requests without a complete response within the request timeout
+    uint32_t connectFailures;   // requests that could not be sent because connecting or writing failed
+    uint32_t poolExhausted;     // requests that found no free client (they were queued or failed)
+    uint32_t bytesSent;
+    uint32_t bytesReceived;
+    uint32_t callbackUs;        // spent in completion callbacks
+    uint32_t latencyHistogram[HTTP_LATENCY_BUCKETS];  // completed requests by total time, see getLatencyBucketLimitMs()
+
+    HttpMetrics() {
+        reset();
+    }
+
+    void reset() {
+        requests = 0;
+        completed = 0;
+        timeouts = 0;
+        connectFailures = 0;
+        poolExhausted = 0;
+        bytesSent = 0;
+        bytesReceived = 0;
+        callbackUs = 0;
+        for (uint8_t i = 0; i < HTTP_LATENCY_BUCKETS; ++i) {
+            latencyHistogram[i] = 0;
+        }
+    }
+
+    void recordLatency(unsigned long latencyMs) {
+        uint8_t bucket = 0;
+        while (bucket < HTTP_LATENCY_BUCKETS - 1 && latencyMs >= getLatencyBucketLimitMs(bucket)) {
+            ++bucket;
+        }
+        ++latencyHistogram[bucket];
+    }
+
+    /// @brief Gets the exclusive upper bound of a latency histogram bucket.
+    /// @return The bound in ms (10, 20, 50, 100, 200, 500, 1000, 2000, 5000); the last bucket is unbounded
+    static unsigned long getLatencyBucketLimitMs(uint8_t bucket) {
+        static const uint16_t limits[HTTP_LATENCY_BUCKETS - 1] = { 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 };
+        return bucket < HTTP_LATENCY_BUCKETS - 1 ? limits[bucket] : 0xFFFFFFFFUL;
+    }
+};
@@ -0,0 +1,68 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpPooledClient.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "UrlParsing.h"
+
+/**
+ * An idle client in the client pool. If the client still holds a keep-alive connection,
+ * host and port identify the origin it is connected to. Secure clients are only used for https URLs.
+ */
+template<typename TClient>
+struct HttpPooledClient {
+    TClient* client;
+    char host[HTTP_MAX_HOST_LENGTH + 1];
+    uint16_t port;
+    unsigned long idleSinceTS;
+    bool secure;
+
+    HttpPooledClient() : client(nullptr), port(0), idleSinceTS(0), secure(false) {
+        host[0] = '\0';
+    }
+
+    bool isConnectedTo(const UrlView& url) const {
+        return secure == url.tls && port == url.port && url.isHost(host);
+    }
+
+    bool holdsConnection() const {
+        return port != 0;
+    }
+
+    void clearConnection() {
+        host[0] = '\0';
+        port = 0;
+    }
+};
+
+/**
+ * Storage for the clients of a pool. A pool without clients constructs no client at all, so a
+ * backend without secure clients never creates an unused TLS client.
+ */
+template<typename TClient, size_t Count>
+class HttpClientArray {
+    public:
+        TClient* get(size_t index) {
+            return &clients[index];
+        }
+
+    private:
+        TClient clients[Count];
+};
+
+template<typename TClient>
+class HttpClientArray<TClient, 0> {
+    public:
+        TClient* get(size_t) {
+            return nullptr;
+        }
+};
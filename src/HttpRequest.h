@@ -13,16 +13,208 @@
 
 #include "Client.h"
 #include "HttpCallback.h"
+#include "HttpResponseParsing.h"
+#include "HttpRequestOptions.h"
+#include "HttpRequestBody.h"
+#include "UrlParsing.h"
+#include "HttpEndpoint.h"
+
+// Bodies up to this length are kept in the request slot while the connection is established,
+// longer ones are copied to the heap
+#ifndef HTTP_KEPT_BODY_LENGTH
+#define HTTP_KEPT_BODY_LENGTH 64
+#endif
+
+enum HttpRequestState {
+    RequestResolving = 0,        // the host name still has to be resolved
+    RequestConnecting = 1,       // the client still has to connect and send the request
+    RequestAwaitingResponse = 2  // the request has been sent
+};
 
 template<typename TClient>
 struct HttpRequest {
     TClient* client;
     RequestCompletedCallback* callback;
+    uint32_t requestId;
+    void* userContext;
     unsigned long requestStartTS;
+    unsigned long acceptedTS;
+    bool receivedFirstByte;
+
+    // Deadlines, see HttpRequestOptions
+    unsigned long connectTimeoutMs;
+    unsigned long firstByteTimeoutMs;
+    unsigned long timeoutMs;
+
+    char host[HTTP_MAX_HOST_LENGTH + 1];
+    uint16_t port;
+    bool tls;
+    bool idempotent;
+    HttpResponseParser parser;
+
+    // Next request pipelined on the same connection. It only starts reading once this one is complete.
+    HttpRequest* pipelineNext;
+
+    // Links within the list of pending requests
+    HttpRequest* listPrevious;
+    HttpRequest* listNext;
+    bool waitingForPipeline;
+    bool discardedBytes;
+    bool timedOut;  // a deadline passed after the response had started to arrive
+    bool retried;   // sent again because the cached body a 304 referred to was dropped
+
+    // Target of the body until it has been deserialized, see HttpRequestOptions::jsonDocument
+    JsonDocument* jsonDocument;
+    const JsonDocument* jsonFilter;
+
+    // Connections are established from loop(). Until the request is sent, it keeps a copy of what it sends.
+    HttpRequestState state;
+    IPAddress address;
+    bool hasAddress;
+    char url[HTTP_MAX_URL_LENGTH + 1];  // empty for requests to an endpoint, which keeps its own URL
+    String longUrl;                     // a URL that does not fit into url
+    HttpEndpoint* endpoint;
+    const char* method;
+    const char* contentType;
+    const HttpHeaders* headers;
+    bool cacheable;  // a GET request whose response goes through the response cache
+    char keptBody[HTTP_KEPT_BODY_LENGTH];
+    uint16_t keptBodyLength;
+    String body;     // a body that does not fit into keptBody
+    bool hasBody;
+    HttpRequestBody bodySource;  // a stream or generator body, read when the request is written
+    bool hasBodySource;
+    bool compressBody;
+    bool acceptCompressed;
+
+#if HTTP_ENABLE_METRICS
+    HttpRequestTimings timings;
+    unsigned long sentUS;
+    unsigned long firstByteUS;
+    unsigned long lastByteUS;
+#endif
     
-    HttpRequest() : client(nullptr), callback(nullptr) {}
+    HttpRequest() : client(nullptr), callback(nullptr), requestId(0), userContext(nullptr), requestStartTS(0), acceptedTS(0), receivedFirstByte(false),
+                    connectTimeoutMs(0), firstByteTimeoutMs(0), timeoutMs(0), port(0), tls(false), idempotent(false), pipelineNext(nullptr), listPrevious(nullptr), listNext(nullptr), waitingForPipeline(false), discardedBytes(false), timedOut(false), retried(false), jsonDocument(nullptr), jsonFilter(nullptr),
+                    state(RequestAwaitingResponse), hasAddress(false), endpoint(nullptr), method(nullptr), contentType(nullptr), headers(nullptr), cacheable(false), keptBodyLength(0), hasBody(false), hasBodySource(false), compressBody(false), acceptCompressed(false) {
+        host[0] = '\0';
+        url[0] = '\0';
+    }
+
+    // Prepares a slot of the request slab for reuse
+    void reset() {
+        client = nullptr;
+        callback = nullptr;
+        requestId = 0;
+        userContext = nullptr;
+        requestStartTS = 0;
+        acceptedTS = 0;
+        receivedFirstByte = false;
+        connectTimeoutMs = 0;
+        firstByteTimeoutMs = 0;
+        timeoutMs = 0;
+        host[0] = '\0';
+        port = 0;
+        tls = false;
+        idempotent = false;
+        parser.reset();
+        parser.setStreamCallbacks(nullptr, nullptr);
+        parser.setPullBody(false);
+        parser.setDecompress(false);
+        pipelineNext = nullptr;
+        waitingForPipeline = false;
+        discardedBytes = false;
+        timedOut = false;
+        retried = false;
+        jsonDocument = nullptr;
+        jsonFilter = nullptr;
+        state = RequestAwaitingResponse;
+        hasAddress = false;
+        endpoint = nullptr;
+        method = nullptr;
+        contentType = nullptr;
+        headers = nullptr;
+        compressBody = false;
+        acceptCompressed = false;
+        cacheable = false;
+        url[0] = '\0';
+        if (longUrl.length() > 0) longUrl = String();
+        releasePayload();
+#if HTTP_ENABLE_METRICS
+        timings = HttpRequestTimings();
+#endif
+    }
+    
+    // Keeps a copy of the body until the request is written
+    void keepBody(const String& value) {
+        if (value.length() <= sizeof(keptBody)) {
+            memcpy(keptBody, value.c_str(), value.length());
+            keptBodyLength = value.length();
+        }
+        else {
+            body = value;
+        }
+        hasBody = true;
+    }
+
+    const char* getBody() const {
+        return body.length() > 0 ? body.c_str() : keptBody;
+    }
+
+    size_t getBodyLength() const {
+        return body.length() > 0 ? body.length() : keptBodyLength;
+    }
+
+    // Keeps a copy of the URL until the request is written or its response is cached
+    void keepUrl(const char* value) {
+        size_t length = strlen(value);
+        if (length <= HTTP_MAX_URL_LENGTH) memcpy(url, value, length + 1);
+        else longUrl = value;
+    }
+
+    const char* getUrl() const {
+        return longUrl.length() > 0 ? longUrl.c_str() : url;
+    }
+
+    // URL the response is cached under
+    const char* getCacheKey() const {
+        return endpoint != nullptr ? endpoint->getUrl().url : getUrl();
+    }
+
+    // Frees the copy of the body once the request has been sent. The URL stays until the response is cached.
+    void releasePayload() {
+        if (body.length() > 0) body = String();
+        keptBodyLength = 0;
+        hasBody = false;
+        hasBodySource = false;
+    }
     
     ~HttpRequest() {
         client = nullptr;
+        pipelineNext = nullptr;
     }
+};
+
+/**
+ * A slot for a request that is waiting for a free client.
+ */
+struct HttpQueuedRequest {
+    bool used;
+    uint32_t sequence;
+    uint32_t requestId;
+    String url;
+    HttpEndpoint* endpoint;
+    const char* method;
+    const char* contentType;
+    String body;
+    bool hasBody;
+    HttpRequestBody bodySource;
+    bool hasBodySource;
+    RequestCompletedCallback* callback;
+    ResponseHeadersCallback* onHeaders;
+    ResponseBodyChunkCallback* onBodyChunk;
+    HttpRequestOptions options;
+    unsigned long queuedTS;
+
+    HttpQueuedRequest() : used(false), sequence(0), requestId(0), endpoint(nullptr), method(nullptr), contentType(nullptr), hasBody(false), hasBodySource(false), callback(nullptr), onHeaders(nullptr), onBodyChunk(nullptr), queuedTS(0) {}
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpRequestBody.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "HttpCallback.h"
+
+enum HttpRequestBodyType {
+    BodyJson = 0,      // a JSON document, serialized while it is written
+    BodyStream = 1,    // read from a Stream (e.g. a File)
+    BodyGenerator = 2  // produced by a RequestBodyChunkCallback
+};
+
+/**
+ * A request body that is written straight to the client instead of being built as a String first.
+ * If the length of a stream or generator body is not known, it is sent with chunked transfer encoding.
+ *
+ * The source is not copied. A JSON document, stream or generator has to stay usable until the
+ * completion callback of the request was invoked, as the body is only read once the connection
+ * has been established. (A JsonDocument passed to post() or put() directly is copied instead.)
+ */
+struct HttpRequestBody {
+    HttpRequestBodyType type;
+    const JsonDocument* json;
+    Stream* stream;
+    RequestBodyChunkCallback* generator;
+    int32_t length;            // number of bytes, -1 if unknown
+    const char* contentType;
+    bool copyWhenKept;         // a JSON document is serialized into a copy if the request is written later
+
+    HttpRequestBody() : type(BodyJson), json(nullptr), stream(nullptr), generator(nullptr), length(-1), contentType(nullptr), copyWhenKept(false) {}
+
+    /// @brief A body serialized from a JSON document, its length is measured up front.
+    static HttpRequestBody fromJson(const JsonDocument& document) {
+        HttpRequestBody body;
+        body.type = BodyJson;
+        body.json = &document;
+        body.contentType = "application/json";
+        return body;
+    }
+
+    /// @brief A body read from a stream until it ends or length bytes have been read.
+    /// @param length The number of bytes to send, -1 to send the stream until it ends with chunked transfer encoding
+    static HttpRequestBody fromStream(Stream& stream, int32_t length = -1, const char* contentType = "application/octet-stream") {
+        HttpRequestBody body;
+        body.type = BodyStream;
+        body.stream = &stream;
+        body.length = length;
+        body.contentType = contentType;
+        return body;
+    }
+
+    /// @brief A body produced by a callback that fills the transmit buffer until it returns 0.
+    /// @param length The number of bytes the callback produces, -1 to send them with chunked transfer encoding
+    static HttpRequestBody fromGenerator(RequestBodyChunkCallback* generator, int32_t length = -1, const char* contentType = "application/octet-stream") {
+        HttpRequestBody body;
+        body.type = BodyGenerator;
+        body.generator = generator;
+        body.length = length;
+        body.contentType = contentType;
+        return body;
+    }
+
+    /// @brief Gets the number of bytes that will be sent, -1 if the body is sent in chunks.
+    int32_t measure() const {
+        return type == BodyJson ? (int32_t)measureJson(*json) : length;
+    }
+
+    /// @brief Reads the next bytes of a stream or generator body.
+    /// @return The number of bytes read, 0 at the end of the body
+    size_t read(uint8_t* buffer, size_t size) const {
+        if (type == BodyStream) return stream->readBytes((char*)buffer, size);
+        if (type == BodyGenerator) return generator(buffer, size);
+        return 0;
+    }
+};
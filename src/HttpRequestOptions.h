@@ -0,0 +1,67 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpRequestOptions.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <ArduinoJson.h>
+#include "HttpHeaders.h"
+
+enum HttpRequestPriority {
+    PriorityLow = 0,
+    PriorityNormal = 1,
+    PriorityHigh = 2
+};
+
+/**
+ * Optional per-request settings that can be passed to get(), post(), put() and del().
+ */
+struct HttpRequestOptions {
+    // Queued requests with a higher priority are sent first once a client becomes available.
+    HttpRequestPriority priority;
+
+    // Deserializes a successful (2xx) response body into this document while it is received instead of
+    // collecting it into HttpResponse::contentText. The result is reported in HttpResponse::jsonError.
+    // The document has to outlive the request. Ignored for streamed requests.
+    JsonDocument* jsonDocument;
+
+    // Optional ArduinoJson filter: only the fields set to true in it are kept in jsonDocument.
+    const JsonDocument* jsonFilter;
+
+    // Passed back in HttpResponse::userContext, e.g. to tell apart the requests a callback is shared by.
+    // It is not used by the library.
+    void* userContext;
+
+    // Additional request headers, sent after the default headers of the Http instance.
+    // The set is not copied and has to outlive the request.
+    const HttpHeaders* headers;
+
+    // Deadlines of this request in milliseconds, 0 uses the settings of the Http instance.
+    // connectTimeoutMs limits resolving the host, connecting and writing the request,
+    // firstByteTimeoutMs the wait for the first bytes of the response once the request has been written,
+    // and timeoutMs the whole request from the call of get(), post(), put() or del(), including the time it was queued.
+    unsigned long connectTimeoutMs;
+    unsigned long firstByteTimeoutMs;
+    unsigned long timeoutMs;
+
+    // Sends the body gzip compressed (Content-Encoding: gzip) with chunked transfer encoding. The body is
+    // compressed while it is written, so neither the body nor its compressed form is held in memory.
+    // The server has to accept compressed request bodies. Only applies to a JsonDocument, stream or
+    // generator body, a body passed as a String is sent uncompressed.
+    bool compressBody;
+
+    // Asks for a compressed response (Accept-Encoding: gzip, deflate) even though the inflate window is
+    // smaller than the 32 KB servers compress with (HTTP_INFLATE_WINDOW_BITS below 15). Only for servers
+    // known to send small bodies or to compress with a small window. Needs Http::setDecompressResponses().
+    bool acceptCompressed;
+
+    HttpRequestOptions() : priority(PriorityNormal), jsonDocument(nullptr), jsonFilter(nullptr), userContext(nullptr), headers(nullptr),
+                           connectTimeoutMs(0), firstByteTimeoutMs(0), timeoutMs(0), compressBody(false), acceptCompressed(false) {}
+};
@@ -0,0 +1,278 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpRequestWriter.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HttpRequestBody.h"
+#include "HttpDeflater.h"
+
+/**
+ * Serializes a request into a fixed transmit buffer and writes it to the client in as few
+ * write() calls as possible. Data that does not fit into the buffer (e.g. a large body) is
+ * written directly after flushing what has been buffered so far. Streamed bodies are read straight
+ * into the free part of the buffer. Compressed bodies are deflated into the buffer chunk by chunk.
+ */
+class HttpRequestWriter {
+    public:
+        HttpRequestWriter(Print& out, char* buffer, size_t capacity) : out(out), buffer(buffer), capacity(capacity), length(0), written(0), failed(false) {}
+
+        void write(const char* data, size_t dataLength) {
+            if (dataLength > capacity - length) {
+                flush();
+                if (dataLength >= capacity) {
+                    writeOut(data, dataLength);
+                    return;
+                }
+            }
+            memcpy(buffer + length, data, dataLength);
+            length += dataLength;
+        }
+
+        void write(const char* str) {
+            write(str, strlen(str));
+        }
+
+        void write(const String& str) {
+            write(str.c_str(), str.length());
+        }
+
+        void writeNumber(unsigned long value) {
+            char digits[10];
+            uint8_t count = 0;
+            do {
+                digits[count++] = '0' + (value % 10);
+                value /= 10;
+            } while (value > 0);
+
+            char reversed[10];
+            for (uint8_t i = 0; i < count; ++i) {
+                reversed[i] = digits[count - 1 - i];
+            }
+            write(reversed, count);
+        }
+
+        /// @brief Writes a "Name: value" header line.
+        void writeHeader(const char* name, const char* value) {
+            write(name);
+            write(": ", 2);
+            write(value);
+            write("\r\n", 2);
+        }
+
+        /// @brief Writes a body from its source without copying it into a String first.
+        /// @param bodyLength The announced Content-Length, -1 to send the body with chunked transfer encoding
+        void writeBody(const HttpRequestBody& body, int32_t bodyLength) {
+            if (body.type == BodyJson) {
+                WriterPrint print(*this);
+                serializeJson(*body.json, print);
+                return;
+            }
+            if (bodyLength >= 0) {
+                writeSized(body, (size_t)bodyLength);
+            }
+            else {
+                writeChunked(body);
+            }
+        }
+
+        /// @brief Writes a body gzip compressed, with chunked transfer encoding as the compressed length is not known up front.
+        void writeCompressedBody(const HttpRequestBody& body) {
+            ChunkPrint chunks(*this);
+            HttpDeflater deflater(chunks);
+            if (deflater.hasFailed()) {
+                failed = true;
+                return;
+            }
+
+            beginChunk();
+            if (body.type == BodyJson) {
+                serializeJson(*body.json, deflater);
+            }
+            else {
+                // the source is read straight into the window of the compressor
+                while (!failed) {
+                    size_t space;
+                    uint8_t* input = deflater.getInputSpace(space);
+                    size_t count = body.read(input, space);
+                    if (count == 0) break;
+                    deflater.commitInput(count);
+                }
+            }
+            deflater.finish();
+            endChunks();
+        }
+
+        /// @brief Writes a body that is already in memory (a serialized JSON document) gzip compressed, with chunked transfer encoding.
+        void writeCompressedBody(const char* body, size_t bodyLength) {
+            ChunkPrint chunks(*this);
+            HttpDeflater deflater(chunks);
+            if (deflater.hasFailed()) {
+                failed = true;
+                return;
+            }
+
+            beginChunk();
+            deflater.write((const uint8_t*)body, bodyLength);
+            deflater.finish();
+            endChunks();
+        }
+
+        /// @brief Writes all buffered bytes to the client.
+        /// @return false if any write to the client failed
+        bool flush() {
+            if (length > 0) {
+                writeOut(buffer, length);
+                length = 0;
+            }
+            return !failed;
+        }
+
+        /// @brief Gets the number of bytes written to the client so far.
+        size_t getBytesWritten() const {
+            return written;
+        }
+
+    private:
+        // Lets serializeJson() write into the transmit buffer
+        class WriterPrint : public Print {
+            public:
+                explicit WriterPrint(HttpRequestWriter& writer) : writer(writer) {}
+
+                size_t write(uint8_t c) override {
+                    writer.write((const char*)&c, 1);
+                    return 1;
+                }
+
+                size_t write(const uint8_t* data, size_t dataLength) override {
+                    writer.write((const char*)data, dataLength);
+                    return dataLength;
+                }
+
+            private:
+                HttpRequestWriter& writer;
+        };
+
+        // Lets the compressor write into the current chunk
+        class ChunkPrint : public Print {
+            public:
+                explicit ChunkPrint(HttpRequestWriter& writer) : writer(writer) {}
+
+                size_t write(uint8_t c) override {
+                    writer.writeChunkData((const char*)&c, 1);
+                    return 1;
+                }
+
+                size_t write(const uint8_t* data, size_t dataLength) override {
+                    writer.writeChunkData((const char*)data, dataLength);
+                    return dataLength;
+                }
+
+            private:
+                HttpRequestWriter& writer;
+        };
+
+        // Size of the "XXXX\r\n" line in front of every chunk, chunks never exceed 0xFFFF bytes
+        static const size_t ChunkHeaderLength = 6;
+
+        Print& out;
+        char* buffer;
+        size_t capacity;
+        size_t length;
+        size_t written;
+        bool failed;
+
+        // Reads exactly bodyLength bytes from the source straight into the free part of the buffer
+        void writeSized(const HttpRequestBody& body, size_t bodyLength) {
+            while (bodyLength > 0 && !failed) {
+                if (length == capacity) flush();
+
+                size_t space = capacity - length;
+                if (space > bodyLength) space = bodyLength;
+                size_t count = body.read((uint8_t*)buffer + length, space);
+                if (count == 0) {
+                    // the source ended before the announced Content-Length
+                    failed = true;
+                    return;
+                }
+                length += count;
+                bodyLength -= count;
+            }
+        }
+
+        // Sends the source in chunks of one buffer each
+        void writeChunked(const HttpRequestBody& body) {
+            while (!failed) {
+                beginChunk();
+                size_t count = body.read((uint8_t*)buffer + length, getChunkSpace());
+                if (count == 0) break;
+                length += count;
+                endChunk();
+            }
+            endChunks();
+        }
+
+        // Starts a chunk at the beginning of the buffer, its size is written in front once it is known
+        void beginChunk() {
+            flush();
+            length = ChunkHeaderLength;
+        }
+
+        size_t getChunkSpace() const {
+            size_t space = capacity - length - 2;
+            size_t maxSpace = 0xFFFF + ChunkHeaderLength - length;
+            return space < maxSpace ? space : maxSpace;
+        }
+
+        void writeChunkData(const char* data, size_t dataLength) {
+            while (dataLength > 0 && !failed) {
+                size_t space = getChunkSpace();
+                if (space == 0) {
+                    endChunk();
+                    beginChunk();
+                    continue;
+                }
+                size_t count = dataLength < space ? dataLength : space;
+                memcpy(buffer + length, data, count);
+                length += count;
+                data += count;
+                dataLength -= count;
+            }
+        }
+
+        void endChunk() {
+            size_t count = length - ChunkHeaderLength;
+            static const char hexDigits[] = "0123456789abcdef";
+            for (uint8_t i = 0; i < 4; ++i) {
+                buffer[i] = hexDigits[(count >> (12 - 4 * i)) & 0xF];
+            }
+            buffer[4] = '\r';
+            buffer[5] = '\n';
+            buffer[length++] = '\r';
+            buffer[length++] = '\n';
+            flush();
+        }
+
+        // Ends the current chunk unless it is empty and writes the last chunk
+        void endChunks() {
+            if (length > ChunkHeaderLength) endChunk();
+            else length = 0;
+            write("0\r\n\r\n", 5);
+        }
+
+        void writeOut(const char* data, size_t dataLength) {
+            size_t count = out.write((const uint8_t*)data, dataLength);
+            written += count;
+            if (count != dataLength) {
+                failed = true;
+            }
+        }
+};
@@ -13,15 +13,21 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include "HttpHeaderTable.h"
+#include "HttpMetrics.h"
 
 enum HttpRequstStatus {
     Sent = 1,
     Completed = 2,
     NoResponse = 3,
+    Queued = 4,
     Failed_UnableToConnectToServer = 30,
     Failed_InvalidUrl = 31,
     Failed_UnableToSerializeBody = 32,
-    Failed_TooManyConcurrentRequests = 33
+    Failed_TooManyConcurrentRequests = 33,
+    Failed_IncompleteResponse = 34,     // the connection closed before the end of the Content-Length or chunked body, or its chunk framing was invalid
+    Failed_TimedOut = 35,               // a deadline passed after the response had started to arrive
+    Failed_UnableToDecompressBody = 36  // the compressed body was corrupt or referred further back than the inflate window
 };
 
 struct HttpResponse {
@@ -32,7 +38,51 @@ struct HttpResponse {
     String server;
     String contentText;
 
+    // Result of deserializing the body into HttpRequestOptions::jsonDocument
+    DeserializationError jsonError;
+
+    // ID of the request, see Http::getLastRequestId()
+    uint32_t requestId;
+
+    // HttpRequestOptions::userContext of the request
+    void* userContext;
+
+    // Set if the server answered 304 Not Modified and the body is the one of the response cache
+    bool fromCache;
+
+    // Set if the body was compressed and could not be inflated, the rest of it was dropped
+    // and the request completed with Failed_UnableToDecompressBody
+    bool decompressionFailed;
+
+    // Headers registered with Http::captureResponseHeader() and their null-terminated values
+    const HttpHeaderTable* headerTable;
+    uint16_t headerOffsets[HTTP_MAX_RESPONSE_HEADERS > 0 ? HTTP_MAX_RESPONSE_HEADERS : 1];
+    char headerValues[HTTP_RESPONSE_HEADER_BUFFER_SIZE];
+
+#if HTTP_ENABLE_METRICS
+    HttpRequestTimings timings;
+#endif
+
+    HttpResponse() : status(HttpRequstStatus::NoResponse), responseCode(0), contentLength(0), jsonError(DeserializationError::Ok), requestId(0), userContext(nullptr), fromCache(false), decompressionFailed(false), headerTable(nullptr), headerValues() {
+        for (uint8_t i = 0; i < HTTP_MAX_RESPONSE_HEADERS; ++i) {
+            headerOffsets[i] = NoHeaderValue;
+        }
+    }
+
     DeserializationError asJson(JsonDocument &doc) {
         return deserializeJson(doc, contentText);
     }
+
+    /// @brief Gets the value of a captured response header.
+    /// @param name The header name (case-insensitive). It has to be registered with Http::captureResponseHeader().
+    /// @return The value or nullptr if the header was not registered, not received or did not fit into the buffer
+    const char* getHeader(const char* name) const {
+        if (headerTable == nullptr) return nullptr;
+
+        int8_t index = headerTable->indexOf(name, strlen(name));
+        if (index < 0 || headerOffsets[index] == NoHeaderValue) return nullptr;
+        return headerValues + headerOffsets[index];
+    }
+
+    static const uint16_t NoHeaderValue = 0xFFFF;
 };
\ No newline at end of file
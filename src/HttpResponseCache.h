@@ -0,0 +1,179 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: HttpResponseCache.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HttpResponse.h"
+
+// Longest ETag or Last-Modified value that is remembered
+#ifndef HTTP_CACHE_VALIDATOR_LENGTH
+#define HTTP_CACHE_VALIDATOR_LENGTH 64
+#endif
+
+/**
+ * Remembers the bodies of GET responses that came with an ETag or Last-Modified header, so the
+ * next request for the same URL can be sent conditionally. Responses marked with Cache-Control
+ * no-store and bodies whose end could not be verified are not stored. As the cache belongs to a single
+ * client, responses marked private are stored. If the server answers with 304 Not Modified, the stored
+ * body is handed out instead. When all entries are in use, the one used least recently is replaced.
+ */
+class HttpResponseCache {
+public:
+    HttpResponseCache() : entries(nullptr), size(0), useCounter(0) {}
+
+    ~HttpResponseCache() {
+        delete[] entries;
+    }
+
+    HttpResponseCache(const HttpResponseCache&) = delete;
+    HttpResponseCache& operator=(const HttpResponseCache&) = delete;
+
+    /// @brief Sets the number of entries (0 disables the cache). Drops all entries.
+    void setSize(size_t size) {
+        if (size == this->size) {
+            clear();
+            return;
+        }
+        delete[] entries;
+        entries = size > 0 ? new Entry[size] : nullptr;
+        this->size = size;
+        useCounter = 0;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    /// @brief Looks up the validators of a URL.
+    /// @return false if no response of the URL is stored
+    bool getValidators(const char* url, const char*& etag, const char*& lastModified) const {
+        const Entry* entry = find(url);
+        if (entry == nullptr) return false;
+
+        etag = entry->etag[0] != '\0' ? entry->etag : nullptr;
+        lastModified = entry->lastModified[0] != '\0' ? entry->lastModified : nullptr;
+        return true;
+    }
+
+    /// @brief Updates the cache with a completed response to a GET request of the URL.
+    /// A 200 response with validators is stored, a 304 response is replaced by the stored one.
+    /// @param complete Whether the body ended with its Content-Length or the terminating chunk
+    /// @return false if the response is a 304 whose stored body was dropped in the meantime
+    bool update(const char* url, HttpResponse& response, bool complete) {
+        Entry* entry = find(url);
+
+        if (response.responseCode == 304) {
+            if (entry == nullptr) return false;
+            // the server might have sent new validators along
+            copyValidators(*entry, response);
+            entry->usedCount = ++useCounter;
+
+            response.responseCode = 200;
+            response.contentType = entry->contentType;
+            response.contentText = entry->body;
+            response.contentLength = entry->body.length();
+            response.fromCache = true;
+            return true;
+        }
+
+        const char* etag = response.getHeader("ETag");
+        const char* lastModified = response.getHeader("Last-Modified");
+        const char* cacheControl = response.getHeader("Cache-Control");
+        if (response.responseCode != 200 || !complete || response.decompressionFailed || !fits(etag) || !fits(lastModified) ||
+            (etag == nullptr && lastModified == nullptr) || hasDirective(cacheControl, "no-store")) {
+            // the stored body is outdated
+            if (entry != nullptr) *entry = Entry();
+            return true;
+        }
+
+        if (entry == nullptr) entry = leastRecentlyUsed();
+        *entry = Entry();
+        entry->url = url;
+        copyValidators(*entry, response);
+        entry->contentType = response.contentType;
+        entry->body = response.contentText;
+        entry->usedCount = ++useCounter;
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size; ++i) {
+            entries[i] = Entry();
+        }
+        useCounter = 0;
+    }
+
+private:
+    struct Entry {
+        String url;
+        char etag[HTTP_CACHE_VALIDATOR_LENGTH + 1];
+        char lastModified[HTTP_CACHE_VALIDATOR_LENGTH + 1];
+        String contentType;
+        String body;
+        uint32_t usedCount;
+
+        Entry() : etag(), lastModified(), usedCount(0) {}
+    };
+
+    Entry* entries;
+    size_t size;
+    uint32_t useCounter;
+
+    Entry* find(const char* url) const {
+        for (size_t i = 0; i < size; ++i) {
+            if (entries[i].url.length() > 0 && strcmp(entries[i].url.c_str(), url) == 0) return &entries[i];
+        }
+        return nullptr;
+    }
+
+    Entry* leastRecentlyUsed() {
+        Entry* entry = &entries[0];
+        if (entry->url.length() == 0) return entry;
+        for (size_t i = 1; i < size; ++i) {
+            if (entries[i].url.length() == 0) return &entries[i];
+            if ((int32_t)(entries[i].usedCount - entry->usedCount) < 0) entry = &entries[i];
+        }
+        return entry;
+    }
+
+    // Looks for a directive in a comma-separated list like "private, max-age=60"
+    static bool hasDirective(const char* value, const char* directive) {
+        if (value == nullptr) return false;
+
+        size_t length = strlen(directive);
+        while (*value != '\0') {
+            while (*value == ' ' || *value == ',') ++value;
+            if (strncasecmp(value, directive, length) == 0) {
+                char next = value[length];
+                if (next == '\0' || next == ',' || next == '=' || next == ' ') return true;
+            }
+            // skip to the next directive, a quoted argument may contain commas
+            bool quoted = false;
+            for (; *value != '\0' && (quoted || *value != ','); ++value) {
+                if (*value == '"') quoted = !quoted;
+            }
+        }
+        return false;
+    }
+
+    static bool fits(const char* validator) {
+        return validator == nullptr || strlen(validator) <= HTTP_CACHE_VALIDATOR_LENGTH;
+    }
+
+    // Takes over the validators the response comes with, the others are kept
+    static void copyValidators(Entry& entry, const HttpResponse& response) {
+        const char* etag = response.getHeader("ETag");
+        const char* lastModified = response.getHeader("Last-Modified");
+        if (etag != nullptr && fits(etag)) strcpy(entry.etag, etag);
+        if (lastModified != nullptr && fits(lastModified)) strcpy(entry.lastModified, lastModified);
+    }
+};
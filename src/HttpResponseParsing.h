@@ -13,81 +13,683 @@
 #pragma once
 #include <Arduino.h>
 #include "HttpResponse.h"
+#include "HttpCallback.h"
+#include "HttpHeaderTable.h"
+#include "HttpInflater.h"
 
-class HttpResponseParsing {
+enum HttpResponseParserState {
+    ParsingStatusLine = 0,
+    ParsingHeaders = 1,
+    ParsingBody = 2,
+    ParsingDone = 3
+};
+
+enum HttpChunkState {
+    ChunkSize = 0,     // hex size line, optionally followed by extensions
+    ChunkData = 1,
+    ChunkDataEnd = 2,  // CRLF after the chunk data
+    ChunkTrailer = 3   // trailer fields after the last chunk, terminated by an empty line
+};
+
+/**
+ * Incremental HTTP response parser.
+ *
+ * Bytes can be fed in arbitrary slices as they arrive from the network. The parser walks through
+ * status line -> headers -> body and reports completion once the message is finished according to
+ * its Content-Length or chunked transfer encoding (or once finish() is called because the server
+ * closed the connection). Chunk framing is removed as the bytes arrive, so the body is never
+ * buffered in its encoded form.
+ *
+ * By default the body is collected into response.contentText. When a body chunk callback is set
+ * the body is instead handed out slice by slice and never buffered. With setPullBody() the slices
+ * are held for the caller to take with getBodySlice() instead.
+ *
+ * With setDecompress() a gzip or deflate encoded body is inflated on the fly before it is handed out
+ * in any of these ways. The inflater and its window are only allocated while such a body is received.
+ *
+ * Status line and headers are parsed in a single pass over the received bytes. Header names are
+ * matched case-insensitively by length and first character. Values are only copied for the headers
+ * HttpResponse provides and for the ones registered in the header table; all others are skipped.
+ */
+class HttpResponseParser {
     public:
-        static HttpResponse parseResponse(String &response) {
-            const size_t responseLenght = response.length();
-            String line = String();
-            char c;
-            HttpResponse result;
-            result.responseCode = 0;
-            result.contentLength = 0;
-
-            for (size_t i = 0; i < responseLenght; ++i) {
-                c = response[i];
-                if (c != '\n') {
-                    line.concat(c);
-                    continue;
-                }
-                line.trim();
+        HttpResponse response;
+
+        HttpResponseParser() : onHeaders(nullptr), onBodyChunk(nullptr), pullBody(false), decompress(false), inflater(nullptr), headerTable(nullptr) {
+            reset();
+        }
+
+        ~HttpResponseParser() {
+            delete inflater;
+        }
+
+        HttpResponseParser(const HttpResponseParser&) = delete;
+        HttpResponseParser& operator=(const HttpResponseParser&) = delete;
+
+        /// @brief Sets the additional headers whose values are captured into the response.
+        /// @param table The registered headers (may be nullptr). It has to outlive the parser.
+        void setHeaderTable(const HttpHeaderTable* table) {
+            headerTable = table;
+            response.headerTable = table;
+        }
 
-                if (line.startsWith("HTTP/")) {
-                    result.responseCode = parseResponseCode(line);
+        /// @brief Streams the response instead of collecting the body into contentText.
+        /// @param headersCallback Invoked once all headers have been parsed (may be nullptr)
+        /// @param bodyChunkCallback Invoked for every received slice of the body (may be nullptr)
+        void setStreamCallbacks(ResponseHeadersCallback* headersCallback, ResponseBodyChunkCallback* bodyChunkCallback) {
+            onHeaders = headersCallback;
+            onBodyChunk = bodyChunkCallback;
+        }
+
+        /// @brief Holds the body for the caller instead of collecting it or passing it to the body chunk callback.
+        /// consume() returns once the headers are complete and after every slice of the body, which is
+        /// then available from getBodySlice() until the next call.
+        void setPullBody(bool enabled) {
+            pullBody = enabled;
+        }
+
+        /// @brief Inflates bodies with a Content-Encoding of gzip or deflate. Other encodings are passed on as they are.
+        void setDecompress(bool enabled) {
+            decompress = enabled;
+        }
+
+        /// @brief Gets the slice of the body delivered by the last call to consume() in pull mode.
+        /// @param length Receives the length of the slice (0 if there is none)
+        /// @return The slice, pointing into the bytes passed to consume() or into the inflate window
+        const char* getBodySlice(size_t& length) const {
+            length = bodySliceLength;
+            return bodySlice;
+        }
+
+        /// @brief Resets the parser so it can be used for a new response.
+        void reset() {
+            response = HttpResponse();
+            response.responseCode = 0;
+            response.contentLength = 0;
+            response.headerTable = headerTable;
+            state = ParsingStatusLine;
+            statusField = 0;
+            inHeaderValue = false;
+            valueStarted = false;
+            currentHeader = HeaderOther;
+            tokenLength = 0;
+            tokenOverflow = false;
+            headerValuesUsed = 0;
+            captureStart = 0;
+            captureOverflow = false;
+            hasContentLength = false;
+            chunked = false;
+            keepConnection = false;
+            truncated = false;
+            malformed = false;
+            closeDelimited = false;
+            bodyReceived = 0;
+            chunkState = ChunkSize;
+            chunkRemaining = 0;
+            chunkSizeDigits = 0;
+            chunkExtension = false;
+            trailerLineEmpty = true;
+            bodySlice = nullptr;
+            bodySliceLength = 0;
+            contentEncoding = EncodingIdentity;
+            delete inflater;
+            inflater = nullptr;
+        }
+
+        /// @brief Feeds received bytes into the parser.
+        /// @param data The received bytes
+        /// @param length The number of received bytes
+        /// @return The number of bytes consumed. Bytes after the end of the message are not consumed.
+        size_t consume(const char* data, size_t length) {
+            size_t i = 0;
+            bodySliceLength = 0;
+
+            // in pull mode the inflater may still hold bytes of what was passed before
+            if (hasPendingBody()) {
+                inflateBody(data, 0);
+                if (hasContentLength && bodyReceived >= response.contentLength && !hasPendingBody()) endBody();
+                if (bodySliceLength > 0) return 0;
+            }
+
+            while (i < length && state != ParsingDone) {
+                if (state == ParsingBody) {
+                    i += consumeBody(data + i, length - i);
+                    if (pullBody && bodySliceLength > 0) break;
+                }
+                else if (state == ParsingStatusLine) {
+                    consumeStatusLine(data[i++]);
                 }
-                else if (line.startsWith("Content-Type")) {
-                    result.contentType = getStringAfterColon(line);
+                else if (inHeaderValue) {
+                    i += consumeHeaderValue(data + i, length - i);
                 }
-                else if (line.startsWith("Content-Length")) {
-                    result.contentLength = getStringAfterColon(line).toInt();
+                else {
+                    consumeHeaderName(data[i++]);
+                    if (pullBody && state == ParsingBody) break;
+                }
+            }
+            return i;
+        }
+
+        /// @brief Signals that no more bytes will arrive (e.g. the server closed the connection).
+        void finish() {
+            if (state == ParsingDone) return;
+            if (state == ParsingBody && inflater != nullptr && !inflater->isDone()) response.decompressionFailed = true;
+            if (state == ParsingBody && (!hasContentLength || chunked)) {
+                response.contentLength = bodyReceived;
+            }
+            // only a body without Content-Length or chunked encoding ends with the connection
+            truncated = state == ParsingHeaders || (state == ParsingBody && (hasContentLength || chunked));
+            closeDelimited = state == ParsingBody && !hasContentLength && !chunked;
+            keepConnection = false;
+            state = ParsingDone;
+        }
+
+        /// @brief Whether the complete message has been received.
+        bool isDone() const {
+            return state == ParsingDone;
+        }
+
+        /// @brief Whether inflated bytes are waiting to be handed out, see consume().
+        /// In pull mode consume() has to be called until this is false, even without further bytes.
+        bool hasPendingBody() const {
+            return state == ParsingBody && inflater != nullptr && !response.decompressionFailed && inflater->isOutputPending();
+        }
+
+        /// @brief Whether the connection closed before the headers or the body announced by them were complete.
+        bool isTruncated() const {
+            return truncated;
+        }
+
+        /// @brief Whether the chunk framing of the body was invalid (an empty or oversized chunk size line),
+        /// so the rest of the message was not parsed.
+        bool isMalformed() const {
+            return malformed;
+        }
+
+        /// @brief Whether the body had neither Content-Length nor chunked encoding and ended with the connection,
+        /// so there is no telling whether it is complete.
+        bool isDelimitedByClose() const {
+            return closeDelimited;
+        }
+
+        /// @brief Whether at least the status line of the response has been received.
+        bool hasStatusLine() const {
+            return state != ParsingStatusLine;
+        }
+
+        /// @brief Whether the message was delimited without closing the connection and the server allows reusing it.
+        bool isConnectionReusable() const {
+            return state == ParsingDone && keepConnection;
+        }
+
+        HttpResponseParserState getState() const {
+            return state;
+        }
+
+    private:
+        HttpResponseParserState state;
+        ResponseHeadersCallback* onHeaders;
+        ResponseBodyChunkCallback* onBodyChunk;
+        bool pullBody;
+        bool decompress;
+        HttpContentEncoding contentEncoding;
+        HttpInflater* inflater;
+        const char* bodySlice;
+        size_t bodySliceLength;
+        bool hasContentLength;
+        bool chunked;
+        bool keepConnection;
+        bool truncated;
+        bool malformed;
+        bool closeDelimited;
+        size_t bodyReceived;
+        HttpChunkState chunkState;
+        size_t chunkRemaining;
+        uint8_t chunkSizeDigits;
+        bool chunkExtension;
+        bool trailerLineEmpty;
+
+        enum HeaderId {
+            HeaderOther = 0,
+            HeaderContentType = 1,
+            HeaderContentLength = 2,
+            HeaderServer = 3,
+            HeaderConnection = 4,
+            HeaderTransferEncoding = 5,
+            HeaderContentEncoding = 6,
+            HeaderCaptured = 7  // HeaderCaptured + index in the header table
+        };
+
+        const HttpHeaderTable* headerTable;
+        uint8_t statusField;    // 0: version, 1: status code, 2: reason phrase
+        bool inHeaderValue;
+        bool valueStarted;
+        uint8_t currentHeader;
+        char token[HTTP_MAX_HEADER_NAME_LENGTH];  // lower case header name, HTTP version or value token
+        uint8_t tokenLength;
+        bool tokenOverflow;
+        uint16_t headerValuesUsed;
+        uint16_t captureStart;
+        bool captureOverflow;
+
+        void consumeStatusLine(char c) {
+            if (c == '\n') {
+                // tolerate empty lines before the status line
+                if (statusField == 0 && tokenLength == 0) return;
+
+                keepConnection = !(tokenLength == 8 && memcmp(token, "http/1.0", 8) == 0);
+                tokenLength = 0;
+                tokenOverflow = false;
+                state = ParsingHeaders;
+            }
+            else if (c == '\r') {
+                return;
+            }
+            else if (statusField == 0) {
+                if (c == ' ') statusField = 1;
+                else appendToken(c);
+            }
+            else if (statusField == 1) {
+                if (c >= '0' && c <= '9') response.responseCode = response.responseCode * 10 + (c - '0');
+                else if (c == ' ' && response.responseCode > 0) statusField = 2;
+            }
+        }
+
+        void consumeHeaderName(char c) {
+            if (c == '\n') {
+                bool emptyLine = tokenLength == 0;
+                tokenLength = 0;
+                tokenOverflow = false;
+                if (emptyLine) beginBody();
+            }
+            else if (c == ':') {
+                beginHeaderValue();
+            }
+            else if (c != '\r') {
+                appendToken(c);
+            }
+        }
+
+        void beginHeaderValue() {
+            currentHeader = tokenOverflow ? (uint8_t)HeaderOther : findHeader(token, tokenLength);
+            tokenLength = 0;
+            tokenOverflow = false;
+            inHeaderValue = true;
+            valueStarted = false;
+
+            if (currentHeader == HeaderContentLength) {
+                response.contentLength = 0;
+                hasContentLength = true;
+            }
+            else if (currentHeader >= HeaderCaptured) {
+                // the first occurrence of a captured header is kept
+                if (response.headerOffsets[currentHeader - HeaderCaptured] != HttpResponse::NoHeaderValue) {
+                    currentHeader = HeaderOther;
                 }
-                else if (line.startsWith("Server")) {
-                    result.server = getStringAfterColon(line);
+                captureStart = headerValuesUsed;
+                captureOverflow = false;
+            }
+        }
+
+        // Values are handed on in the slices they arrived in; only token headers are looked at byte by byte.
+        size_t consumeHeaderValue(const char* data, size_t length) {
+            const char* lineEnd = (const char*)memchr(data, '\n', length);
+            size_t count = lineEnd != nullptr ? lineEnd - data : length;
+
+            const char* value = data;
+            size_t valueLength = count;
+            if (!valueStarted) {
+                while (valueLength > 0 && (*value == ' ' || *value == '\t')) {
+                    ++value;
+                    --valueLength;
                 }
-                else if (line.length() == 0 && result.contentLength == 0) {
-                    // detect empty line (start of response body) and generate content length from what is left of the response
-                    result.contentLength = responseLenght - i - 1;
+                valueStarted = valueLength > 0;
+            }
+            if (valueLength > 0) headerValue(value, valueLength);
+
+            if (lineEnd == nullptr) return count;
+
+            endHeaderValue();
+            inHeaderValue = false;
+            return count + 1;
+        }
+
+        void headerValue(const char* value, size_t length) {
+            switch (currentHeader) {
+                case HeaderOther:
+                    return;
+                case HeaderContentType:
+                    response.contentType.concat(value, length);
+                    return;
+                case HeaderServer:
+                    response.server.concat(value, length);
+                    return;
+                case HeaderContentLength:
+                    for (size_t i = 0; i < length; ++i) {
+                        if (value[i] >= '0' && value[i] <= '9') response.contentLength = response.contentLength * 10 + (value[i] - '0');
+                    }
+                    return;
+                case HeaderConnection:
+                case HeaderTransferEncoding:
+                case HeaderContentEncoding:
+                    // comma separated list of tokens
+                    for (size_t i = 0; i < length; ++i) {
+                        char c = value[i];
+                        if (c == ',') endToken();
+                        else if (c != ' ' && c != '\t' && c != '\r') appendToken(c);
+                    }
+                    return;
+                default:
+                    if (captureOverflow || headerValuesUsed + length >= HTTP_RESPONSE_HEADER_BUFFER_SIZE) {
+                        captureOverflow = true;
+                        return;
+                    }
+                    memcpy(response.headerValues + headerValuesUsed, value, length);
+                    headerValuesUsed += length;
+                    return;
+            }
+        }
+
+        void endHeaderValue() {
+            switch (currentHeader) {
+                case HeaderOther:
+                case HeaderContentLength:
+                    break;
+                case HeaderContentType:
+                    response.contentType.trim();
+                    break;
+                case HeaderServer:
+                    response.server.trim();
                     break;
+                case HeaderConnection:
+                case HeaderTransferEncoding:
+                case HeaderContentEncoding:
+                    endToken();
+                    break;
+                default:
+                    // values that do not fit into the buffer are dropped instead of truncated
+                    if (captureOverflow) {
+                        headerValuesUsed = captureStart;
+                        break;
+                    }
+                    while (headerValuesUsed > captureStart && isWhitespace(response.headerValues[headerValuesUsed - 1])) {
+                        --headerValuesUsed;
+                    }
+                    response.headerValues[headerValuesUsed++] = '\0';
+                    response.headerOffsets[currentHeader - HeaderCaptured] = captureStart;
+                    break;
+            }
+            currentHeader = HeaderOther;
+        }
+
+        void endToken() {
+            if (tokenLength > 0 && !tokenOverflow) {
+                if (currentHeader == HeaderConnection) {
+                    if (isToken("close")) keepConnection = false;
+                    else if (isToken("keep-alive")) keepConnection = true;
                 }
+                else if (currentHeader == HeaderContentEncoding) {
+                    // only a single gzip or deflate encoding can be inflated
+                    if (isToken("identity")) {}
+                    else if (contentEncoding == EncodingIdentity && (isToken("gzip") || isToken("x-gzip"))) contentEncoding = EncodingGzip;
+                    else if (contentEncoding == EncodingIdentity && isToken("deflate")) contentEncoding = EncodingDeflate;
+                    else contentEncoding = EncodingUnsupported;
+                }
+                else {
+                    // chunked is always the last encoding applied
+                    chunked = isToken("chunked");
+                }
+            }
+            tokenLength = 0;
+            tokenOverflow = false;
+        }
 
-                line = String();
+        void appendToken(char c) {
+            if (tokenLength < sizeof(token)) {
+                token[tokenLength++] = HttpHeaderTable::toLower(c);
+            }
+            else {
+                tokenOverflow = true;
             }
+        }
 
-            if (result.contentLength > 0) {
-                result.contentText = response.substring(responseLenght - result.contentLength);
+        bool isToken(const char* value) const {
+            return strlen(value) == tokenLength && memcmp(token, value, tokenLength) == 0;
+        }
+
+        // name has to be lower case
+        uint8_t findHeader(const char* name, uint8_t length) const {
+            switch (length) {
+                case 6:
+                    if (name[0] == 's' && memcmp(name, "server", 6) == 0) return HeaderServer;
+                    break;
+                case 10:
+                    if (name[0] == 'c' && memcmp(name, "connection", 10) == 0) return HeaderConnection;
+                    break;
+                case 12:
+                    if (name[0] == 'c' && memcmp(name, "content-type", 12) == 0) return HeaderContentType;
+                    break;
+                case 14:
+                    if (name[0] == 'c' && memcmp(name, "content-length", 14) == 0) return HeaderContentLength;
+                    break;
+                case 16:
+                    if (name[0] == 'c' && memcmp(name, "content-encoding", 16) == 0) return HeaderContentEncoding;
+                    break;
+                case 17:
+                    if (name[0] == 't' && memcmp(name, "transfer-encoding", 17) == 0) return HeaderTransferEncoding;
+                    break;
             }
 
-            return result;
+            int8_t index = headerTable != nullptr && length > 0 ? headerTable->indexOf(name, length) : -1;
+            return index >= 0 ? HeaderCaptured + index : HeaderOther;
         }
 
-    private:
-        static size_t parseResponseCode(String &line) {
-            bool inResponse = false;
-            size_t lineLength = line.length();
-            String codeStr = String();
-            char c;
-            for (int16_t i = 0; i < lineLength; ++i) {
-                c = line[i];
-                if (c == ' ') {
-                    if (!inResponse) {
-                        inResponse = true;
-                        continue;
+        static bool isWhitespace(char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        void beginBody() {
+            size_t code = response.responseCode;
+
+            // interim responses (e.g. "100 Continue") are followed by the actual response
+            if (code >= 100 && code < 200) {
+                // the request the response belongs to stays the same
+                uint32_t requestId = response.requestId;
+                void* userContext = response.userContext;
+                reset();
+                response.requestId = requestId;
+                response.userContext = userContext;
+                return;
+            }
+
+            if (onHeaders != nullptr) {
+                onHeaders(response);
+            }
+
+            // "No Content" and "Not Modified" responses never carry a body
+            if (code == 204 || code == 304 || (!chunked && hasContentLength && response.contentLength == 0)) {
+                state = ParsingDone;
+                return;
+            }
+
+            // a chunked body carries its own framing and any Content-Length has to be ignored
+            if (chunked) {
+                hasContentLength = false;
+                response.contentLength = 0;
+            }
+
+            // without a length the body can only be delimited by closing the connection
+            if (!hasContentLength && !chunked) {
+                keepConnection = false;
+            }
+
+            if (decompress && (contentEncoding == EncodingGzip || contentEncoding == EncodingDeflate)) {
+                inflater = new HttpInflater(contentEncoding);
+            }
+            else if (hasContentLength && onBodyChunk == nullptr && !pullBody) {
+                response.contentText.reserve(response.contentLength);
+            }
+            state = ParsingBody;
+        }
+
+        size_t consumeBody(const char* data, size_t length) {
+            if (chunked) {
+                return consumeChunked(data, length);
+            }
+
+            size_t count = length;
+            if (hasContentLength && count > response.contentLength - bodyReceived) {
+                count = response.contentLength - bodyReceived;
+            }
+
+            count = deliverBody(data, count);
+
+            // inflated bytes that are still pending are handed out before the body ends
+            if (hasContentLength && bodyReceived >= response.contentLength && !hasPendingBody()) {
+                endBody();
+            }
+            return count;
+        }
+
+        // Chunk data is passed on in one piece, the framing around it is parsed byte by byte.
+        size_t consumeChunked(const char* data, size_t length) {
+            if (chunkState == ChunkData) {
+                size_t count = length < chunkRemaining ? length : chunkRemaining;
+                count = deliverBody(data, count);
+                chunkRemaining -= count;
+                if (chunkRemaining == 0) chunkState = ChunkDataEnd;
+                return count;
+            }
+
+            char c = data[0];
+            if (chunkState == ChunkSize) {
+                if (c == '\n') {
+                    if (chunkSizeDigits == 0) {
+                        // an empty size line is not the last chunk, the framing is lost
+                        failChunked();
+                        return 1;
                     }
-                    else {
-                        break;
+                    // a chunk of size zero is the last one
+                    chunkState = chunkRemaining > 0 ? ChunkData : ChunkTrailer;
+                    chunkSizeDigits = 0;
+                    chunkExtension = false;
+                    trailerLineEmpty = true;
+                }
+                else if (!chunkExtension && hexValue(c) >= 0) {
+                    if (chunkRemaining > ((size_t)-1 >> 4)) {
+                        // the size does not fit, it would wrap around
+                        failChunked();
+                        return 1;
                     }
+                    chunkRemaining = chunkRemaining * 16 + hexValue(c);
+                    if (chunkSizeDigits < 255) ++chunkSizeDigits;
+                }
+                else if (c != '\r') {
+                    // chunk extensions (";name=value") and whitespace are ignored
+                    chunkExtension = true;
+                }
+            }
+            else if (chunkState == ChunkDataEnd) {
+                if (c == '\n') chunkState = ChunkSize;
+            }
+            else if (c == '\n') {
+                if (trailerLineEmpty) {
+                    response.contentLength = bodyReceived;
+                    endBody();
                 }
-                
-                if (inResponse) codeStr.concat(c);
+                trailerLineEmpty = true;
+            }
+            else if (c != '\r') {
+                trailerLineEmpty = false;
             }
-            return codeStr.toInt();            
+            return 1;
         }
 
-        static String getStringAfterColon(String &line) {
-            size_t colonIndex = line.indexOf(':');
-            if (colonIndex == -1) return String();
-            String result = line.substring(colonIndex+1);
-            result.trim();
-            return result;
+        // Ends the message at an invalid chunk size line, the connection cannot be reused
+        void failChunked() {
+            malformed = true;
+            keepConnection = false;
+            response.contentLength = bodyReceived;
+            state = ParsingDone;
+        }
+
+        // A compressed body has to end with the end of its compressed stream
+        void endBody() {
+            if (inflater != nullptr && !inflater->isDone()) response.decompressionFailed = true;
+            state = ParsingDone;
+        }
+
+        // Returns the number of bytes consumed, in pull mode the inflater may stop before the end of the slice
+        size_t deliverBody(const char* data, size_t count) {
+            if (count == 0) return 0;
+            if (inflater != nullptr) return inflateBody(data, count);
+
+            deliverDecoded(data, count);
+            bodyReceived += count;
+            return count;
+        }
+
+        // Passes compressed bytes through the inflater until all of them are consumed and the window is drained
+        size_t inflateBody(const char* data, size_t count) {
+            if (response.decompressionFailed) {
+                bodyReceived += count;
+                return count;
+            }
+
+            size_t consumed = 0;
+            do {
+                const char* output;
+                size_t outputLength;
+                size_t used = inflater->inflate((const uint8_t*)data + consumed, count - consumed, output, outputLength);
+                consumed += used;
+                deliverDecoded(output, outputLength);
+
+                if (used == 0 && outputLength == 0 && consumed < count) {
+                    // an inflater that makes no progress would be called forever, the rest of the body is dropped
+                    response.decompressionFailed = true;
+                    consumed = count;
+                    break;
+                }
+                if (pullBody && outputLength > 0) break;
+            } while (!inflater->hasFailed() && (consumed < count || inflater->isOutputPending()));
+
+            if (inflater->hasFailed()) response.decompressionFailed = true;
+            bodyReceived += consumed;
+            return consumed;
+        }
+
+        void deliverDecoded(const char* data, size_t count) {
+            if (count == 0) return;
+
+            if (pullBody) {
+                bodySlice = data;
+                bodySliceLength = count;
+            }
+            else if (onBodyChunk != nullptr) {
+                onBodyChunk(response, (const uint8_t*)data, count);
+            }
+            else {
+                response.contentText.concat(data, count);
+            }
+        }
+
+        static int8_t hexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+};
+
+class HttpResponseParsing {
+    public:
+        /// @brief Parses a response that has already been received in full.
+        /// @param response The raw response text
+        /// @return The parsed response
+        static HttpResponse parseResponse(String &response) {
+            HttpResponseParser parser;
+            parser.consume(response.c_str(), response.length());
+            parser.finish();
+            return parser.response;
         }
 };
\ No newline at end of file
@@ -14,6 +14,13 @@
 #include <WiFi.h>
 #include "Http.h"
 
+#if defined(ESP32)
+#include <WiFiClientSecure.h>
+typedef Http<WiFiClient, DEFAULT_MAX_CLIENTS, DEFAULT_MAX_REQUESTS, HTTP_RESPONSE_BUFFER_SIZE, WiFiClientSecure, DEFAULT_MAX_SECURE_CLIENTS> HttpWifiBase;
+#else
+typedef Http<WiFiClient> HttpWifiBase;
+#endif
+
 /**
  * Used to perform HTTP requests with:
  *   - ESP32 boards
@@ -21,11 +28,54 @@
  *   - Any board using the ESP Arduino core's WiFi library
  *
  * This class implements the HTTP client interface using the ESP WiFi (WiFi.h) driver and WiFiClient.
+ * On ESP32, https URLs are sent with WiFiClientSecure. Its server certificates are verified against
+ * the root certificate set with setCACert() unless verification is turned off with setInsecure().
  */
-class HttpWifi : public Http<WiFiClient> {
+class HttpWifi : public HttpWifiBase {
 public:
     String getLocalIP() override {
         IPAddress ip = WiFi.localIP();
         return String(ip[0]) + String(".") + String(ip[1]) + String(".") + String(ip[2]) + String(".") + String(ip[3]);
     }
+
+    bool resolveHost(const char* host, IPAddress& address) override {
+        return WiFi.hostByName(host, address) == 1;
+    }
+
+#if defined(ESP32)
+    // the ESP32 client connects with a non-blocking socket that is given up after the timeout
+    bool connectClient(WiFiClient* client, const IPAddress& address, uint16_t port, unsigned long timeoutMs) override {
+        return client->connect(address, port, (int32_t)timeoutMs) > 0;
+    }
+
+    bool connectClient(WiFiClient* client, const char* host, uint16_t port, unsigned long timeoutMs) override {
+        return client->connect(host, port, (int32_t)timeoutMs) > 0;
+    }
+
+    bool connectSecureClient(WiFiClientSecure* client, const char* host, uint16_t port, unsigned long timeoutMs) override {
+        // the handshake timeout is given in seconds
+        client->setHandshakeTimeout((timeoutMs + 999) / 1000);
+        return client->connect(host, port, (int32_t)timeoutMs) > 0;
+    }
+
+    /**
+     * @brief Sets the root certificate (PEM) server certificates of https URLs are verified against.
+     *
+     * @param rootCA The certificate. It is not copied and has to outlive this instance (e.g. a string literal).
+     */
+    void setCACert(const char* rootCA) {
+        for (size_t i = 0; i < DEFAULT_MAX_SECURE_CLIENTS; ++i) {
+            getSecureClient(i).setCACert(rootCA);
+        }
+    }
+
+    /**
+     * @brief Turns off the verification of server certificates. Only use this for testing.
+     */
+    void setInsecure() {
+        for (size_t i = 0; i < DEFAULT_MAX_SECURE_CLIENTS; ++i) {
+            getSecureClient(i).setInsecure();
+        }
+    }
+#endif
 };
\ No newline at end of file
@@ -12,6 +12,13 @@
 #pragma once
 
 #include <WiFiNINA.h>
+
+// The NINA module has 4 sockets, all of which are plain clients by default. For https URLs, define
+// DEFAULT_MAX_CLIENTS 3 and DEFAULT_MAX_SECURE_CLIENTS 1 before including this header.
+#ifndef DEFAULT_MAX_SECURE_CLIENTS
+#define DEFAULT_MAX_SECURE_CLIENTS 0
+#endif
+
 #include "Http.h"
 
 /**
@@ -23,11 +30,17 @@
  *   - Any board compatible with the WiFiNINA library
  *
  * This class implements the HTTP client interface using the WiFiNINA driver and WiFiClient.
+ * https URLs are sent with WiFiSSLClient, the TLS handshake runs on the NINA module. Secure clients have
+ * to be enabled with DEFAULT_MAX_SECURE_CLIENTS, see above.
  */
-class HttpWiFiNINA : public Http<WiFiClient>{
+class HttpWiFiNINA : public Http<WiFiClient, DEFAULT_MAX_CLIENTS, DEFAULT_MAX_REQUESTS, HTTP_RESPONSE_BUFFER_SIZE, WiFiSSLClient, DEFAULT_MAX_SECURE_CLIENTS>{
 public:
     String getLocalIP() override {
         IPAddress ip = WiFi.localIP();
         return String(ip[0]) + String(".") + String(ip[1]) + String(".") + String(ip[2]) + String(".") + String(ip[3]);
     }
+
+    bool resolveHost(const char* host, IPAddress& address) override {
+        return WiFi.hostByName(host, address) == 1;
+    }
 };
@@ -11,98 +11,63 @@
 
 #pragma once
 
+/**
+ * Doubly linked list that threads through its items instead of allocating nodes.
+ * Items must provide "T* listPrevious" and "T* listNext" members and can be in at most one list at a time.
+ * Adding and removing items is O(1) and never allocates.
+ */
 template <typename T>
-class ListNode {
-public:
-    T value;
-    ListNode* next;
-
-    ListNode(T val) {
-        value = val;
-        next = nullptr;
-    }
-};
-
-template <typename T>
-class List {
+class LinkedList {
 private:
-    ListNode<T>* head;
+    T* head;
+    T* tail;
     size_t size;
 public:
-    List() {
+    LinkedList() {
         head = nullptr;
+        tail = nullptr;
         size = 0;
     }
 
-    ~List() {
-        clear();
-    }
-
     size_t getSize() const {
         return size;
     }
 
-    void add(const T item) {
-        ++size;
-        ListNode<T>* newNode = new ListNode<T>(item);
-        if (head == nullptr) {
-            head = newNode;
-            return;
-        }
-
-        ListNode<T>* end = head;
-        while (end->next != nullptr) {
-            end = end->next;
-        }
-
-        end->next = newNode;
+    T* first() const {
+        return head;
     }
 
-    bool get(const size_t index, T& item) {
-        if (head == nullptr || index < 0 || index >= size) return false;
+    void add(T* item) {
+        item->listPrevious = tail;
+        item->listNext = nullptr;
 
-        ListNode<T>* current = head;
-        for (int i = 0; i < index; ++i) {
-            if (current == nullptr) return false;  // Safety check
-            current = current->next;
+        if (tail != nullptr) {
+            tail->listNext = item;
         }
-        
-        if (current == nullptr) return false;  // Safety check before accessing value
-        item = current->value;
-        return true;
+        else {
+            head = item;
+        }
+        tail = item;
+        ++size;
     }
 
-    bool removeAt(size_t index) {
-        if (head == nullptr || index < 0 || index >= size) return false;
-
-        ListNode<T>* previous = nullptr;
-        ListNode<T>* removeNode = head;
-        
-        for (size_t i = 0; i < index; ++i) {
-            previous = removeNode;
-            removeNode = removeNode->next;
-        }
-        
-        if (previous != nullptr) {
-            previous->next = removeNode->next;
+    void remove(T* item) {
+        if (item->listPrevious != nullptr) {
+            item->listPrevious->listNext = item->listNext;
         }
         else {
-            head = removeNode->next;
+            head = item->listNext;
         }
-        delete removeNode;
-        --size;
-
-        return true;
-    }
 
-    void clear() {
-        size = 0;
-        ListNode<T>* node = head;
-        while (node != nullptr) {
-            ListNode<T>* temp = node;
-            node = node->next;
-            delete temp;
+        if (item->listNext != nullptr) {
+            item->listNext->listPrevious = item->listPrevious;
         }
-        head = nullptr;
+        else {
+            tail = item->listPrevious;
+        }
+
+        item->listPrevious = nullptr;
+        item->listNext = nullptr;
+        --size;
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,80 @@
+/*
+ * Arduino-Http-Requests Library
+ * File: RingBuffer.h
+ * 
+ * Copyright (c) 2025 Dominik Werner
+ * https://github.com/dowerner/Arduino-Http-Requests
+ *
+ * This file is part of the Arduino-Http-Requests library and is licensed
+ * under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+/**
+ * Fixed-capacity FIFO. The storage is part of the object, so it never allocates.
+ * Adding to the back, removing from the front and indexed access are O(1).
+ */
+template <typename T, size_t Capacity>
+class RingBuffer {
+private:
+    T items[Capacity > 0 ? Capacity : 1];
+    size_t capacity;
+    size_t head;
+    size_t size;
+
+    size_t position(size_t index) const {
+        return (head + index) % capacity;
+    }
+
+public:
+    RingBuffer() {
+        capacity = Capacity > 0 ? Capacity : 1;
+        head = 0;
+        size = 0;
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t getSize() const {
+        return size;
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    bool add(const T& item) {
+        if (size == capacity) return false;
+        items[position(size)] = item;
+        ++size;
+        return true;
+    }
+
+    bool get(const size_t index, T& item) const {
+        if (index >= size) return false;
+        item = items[position(index)];
+        return true;
+    }
+
+    T& operator[](const size_t index) {
+        return items[position(index)];
+    }
+
+    /// @brief Removes the item at the given index. O(1) at the front, otherwise the items behind it move up.
+    bool removeAt(size_t index) {
+        if (index >= size) return false;
+
+        if (index == 0) {
+            head = position(1);
+        }
+        else {
+            for (size_t i = index; i + 1 < size; ++i) {
+                items[position(i)] = items[position(i + 1)];
+            }
+        }
+        --size;
+        return true;
+    }
+};
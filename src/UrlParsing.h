@@ -13,6 +13,17 @@
 
 #include "Arduino.h"
 
+// Longest host name that can be connected to (the name is copied into fixed buffers of this size)
+#ifndef HTTP_MAX_HOST_LENGTH
+#define HTTP_MAX_HOST_LENGTH 64
+#endif
+
+// Longest URL kept in the request slot while a request waits for its connection or its response is
+// cached. Longer URLs are copied to the heap instead.
+#ifndef HTTP_MAX_URL_LENGTH
+#define HTTP_MAX_URL_LENGTH 128
+#endif
+
 struct ParsedUrl {
     String host;
     uint16_t port;
@@ -21,89 +32,156 @@ struct ParsedUrl {
     bool failed;
 };
 
-char HTTPS_SCHEMA_LCASE[] = "https://";
-char SEP[] = "://";
-#define CHAR_NUM_OFFSET 48
-#define HTTPS_SCHEMA_LENGHT 8
-#define LCASE_LETTER_OFFSET 32
+/**
+ * Locates scheme, host, port, path, query and fragment within a URL without copying it.
+ * All parts are offsets into the original string, which therefore has to outlive the view.
+ *
+ * The constructor is constexpr, so constant URLs can be parsed at compile time:
+ *     constexpr UrlView collector("http://collector.local:8080/ingest");
+ *
+ * Layout: scheme://host[:port][/path][?query][#fragment]
+ */
+struct UrlView {
+    const char* url;
+    bool tls;
+    uint16_t hostStart;
+    uint16_t hostEnd;
+    uint16_t pathStart;      // end of the authority, start of the path
+    uint16_t queryStart;     // position of '?' (or fragmentStart if there is no query)
+    uint16_t fragmentStart;  // position of '#' (or end if there is no fragment)
+    uint16_t end;
+    uint16_t port;
+    bool failed;
 
-class UrlParsing {
-    public:
+    constexpr UrlView(const char* url) :
+        url(url),
+        tls(hasPrefix(url, "https://")),
+        hostStart(schemeLength(url)),
+        hostEnd(findAny(url, hostStart, ":/?#")),
+        pathStart(findAny(url, hostEnd, "/?#")),
+        queryStart(findAny(url, pathStart, "?#")),
+        fragmentStart(findAny(url, queryStart, "#")),
+        end(findAny(url, fragmentStart, "")),
+        port(pathStart > hostEnd ? parseNumber(url, hostEnd + 1, pathStart, 0) : (tls ? 443 : 80)),
+        failed(hostStart == 0 || hostEnd == hostStart
+            || !isHost(url, hostStart, hostEnd)
+            || (pathStart > hostEnd && !isPort(url, hostEnd + 1, pathStart))
+            || !isTarget(url, pathStart, end)) {}
+
+    const char* host() const { return url + hostStart; }
+    uint16_t hostLength() const { return hostEnd - hostStart; }
+
+    const char* path() const { return url + pathStart; }
+    uint16_t pathLength() const { return queryStart - pathStart; }
+
+    // query without the leading '?'
+    const char* query() const { return url + (queryStart < fragmentStart ? queryStart + 1 : queryStart); }
+    uint16_t queryLength() const { return queryStart < fragmentStart ? fragmentStart - queryStart - 1 : 0; }
+
+    // fragment without the leading '#'
+    const char* fragment() const { return url + (fragmentStart < end ? fragmentStart + 1 : fragmentStart); }
+    uint16_t fragmentLength() const { return fragmentStart < end ? end - fragmentStart - 1 : 0; }
+
+    // path and query as sent in the request line (the fragment is never sent to the server)
+    const char* target() const { return url + pathStart; }
+    uint16_t targetLength() const { return fragmentStart - pathStart; }
+
+    bool isDefaultPort() const { return port == (tls ? 443 : 80); }
+
+    // host names are case-insensitive
+    bool isHost(const char* other) const {
+        return strncasecmp(other, host(), hostLength()) == 0 && other[hostLength()] == '\0';
+    }
+
+    /// @brief Copies the host as a null-terminated string.
+    /// @return false if the host does not fit into the buffer
+    bool copyHost(char* buffer, size_t size) const {
+        if (hostLength() >= size) return false;
+        memcpy(buffer, host(), hostLength());
+        buffer[hostLength()] = '\0';
+        return true;
+    }
+
+    private:
+        static constexpr char toLower(char c) {
+            return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+        }
 
-        /// @brief Parses the given URL
-        /// @param url The URL to parse
-        /// @return A struct containing host, port and path encoded in the URL
-        static ParsedUrl parseUrl(const char* url) {
-            return UrlParsing::parseUrl(String(url));
+        static constexpr bool hasPrefix(const char* str, const char* prefix) {
+            return *prefix == '\0' || (toLower(*str) == *prefix && hasPrefix(str + 1, prefix + 1));
         }
 
-        /// @brief Parses the given URL
-        /// @param url The URL to parse
-        /// @return A struct containing host, port and path encoded in the URL
-        static ParsedUrl parseUrl(const String& url) {          
-            size_t urlLength = url.length();
-            ParsedUrl result = ParsedUrl();
+        static constexpr uint16_t schemeLength(const char* url) {
+            return hasPrefix(url, "https://") ? 8 : (hasPrefix(url, "http://") ? 7 : 0);
+        }
 
-            String urlLcase = String(url);
-            urlLcase.toLowerCase();
+        static constexpr bool contains(const char* chars, char c) {
+            return *chars != '\0' && (*chars == c || contains(chars + 1, c));
+        }
 
-            result.tls = urlLcase.startsWith("https://");
-            result.port = result.tls ? 443 : 80;
+        // position of the first of the given characters at or after pos, or the end of the string
+        static constexpr uint16_t findAny(const char* url, uint16_t pos, const char* chars) {
+            return (url[pos] == '\0' || contains(chars, url[pos])) ? pos : findAny(url, pos + 1, chars);
+        }
 
-            uint8_t sepPos = 0;
-            uint16_t pos = 0;
+        static constexpr uint32_t parseNumber(const char* url, uint16_t pos, uint16_t end, uint32_t value) {
+            return (pos >= end || value > 65535) ? value : parseNumber(url, pos + 1, end, value * 10 + (url[pos] - '0'));
+        }
 
-            // advance until after the "://"
-            while (sepPos < 3 && pos < urlLength) {
-                if (url[pos] == SEP[sepPos]) {
-                    ++sepPos;
-                }
-                ++pos;
-            }
+        static constexpr bool isHostChar(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_';
+        }
 
-            if (pos == urlLength) {
-                result.failed = true;
-                return result;
-            }
+        static constexpr bool isHost(const char* url, uint16_t pos, uint16_t end) {
+            return pos >= end || (isHostChar(url[pos]) && isHost(url, pos + 1, end));
+        }
 
-            result.failed = false;
-
-            // read host and port if available
-            uint16_t hostStart = pos;
-            uint16_t hostEnd = 0;
-            uint16_t portStart = 0;
-            uint16_t portEnd = 0;
-
-            while (pos++ < urlLength) {
-                if (url[pos] == ':') {
-                    hostEnd = pos;
-
-                    if (++pos < urlLength) {
-                        portStart = pos;
-                    }
-                    else {
-                        break;
-                    }
-                }
-                else if (url[pos] == '/') {
-                    if (portStart > 0) {
-                        portEnd = pos;
-                    }
-                    else {
-                        hostEnd = pos;
-                    }
-                    break;
-                }
-            }
+        static constexpr bool isDigits(const char* url, uint16_t pos, uint16_t end) {
+            return pos >= end || (url[pos] >= '0' && url[pos] <= '9' && isDigits(url, pos + 1, end));
+        }
 
-            result.host = url.substring(hostStart, hostEnd);
-            
-            if (portEnd > 0) {
-                result.port = url.substring(portStart, portEnd).toInt();
-            }
+        static constexpr bool isPort(const char* url, uint16_t start, uint16_t end) {
+            return end > start && end - start <= 5 && isDigits(url, start, end)
+                && parseNumber(url, start, end, 0) > 0 && parseNumber(url, start, end, 0) <= 65535;
+        }
+
+        // path, query and fragment must not contain whitespace or control characters
+        static constexpr bool isTarget(const char* url, uint16_t pos, uint16_t end) {
+            return pos >= end || ((uint8_t)url[pos] > ' ' && url[pos] != 0x7f && isTarget(url, pos + 1, end));
+        }
+};
+
+class UrlParsing {
+    public:
+
+        /// @brief Parses the given URL without copying it
+        /// @param url The URL to parse (must outlive the returned view)
+        /// @return A view with the positions of host, port, path, query and fragment
+        static constexpr UrlView parse(const char* url) {
+            return UrlView(url);
+        }
 
-            // test rest is the resource path
-            result.path = url.substring(pos, urlLength);
+        /// @brief Parses the given URL
+        /// @param url The URL to parse
+        /// @return A struct containing host, port and path encoded in the URL
+        static ParsedUrl parseUrl(const char* url) {
+            UrlView view(url);
+            ParsedUrl result = ParsedUrl();
+            result.tls = view.tls;
+            result.port = view.port;
+            result.failed = view.failed;
+
+            if (!view.failed) {
+                result.host.concat(view.host(), view.hostLength());
+                result.path.concat(view.target(), view.targetLength());
+            }
             return result;
         }
-};
\ No newline at end of file
+
+        /// @brief Parses the given URL
+        /// @param url The URL to parse
+        /// @return A struct containing host, port and path encoded in the URL
+        static ParsedUrl parseUrl(const String& url) {
+            return parseUrl(url.c_str());
+        }
+};